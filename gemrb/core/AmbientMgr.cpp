@@ -25,12 +25,28 @@
 #include "Interface.h"
 #include "RNG.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <climits>
 
 namespace GemRB {
 
+// side of the square cells used to find out of range ambients near the listener
+static const int AMBIENT_CELL_SIZE = 512;
+// how often the unscheduled sources get rechecked
+static const tick_t AMBIENT_RECHECK_DELAY = 1000;
+
+static int CellOf(int coord)
+{
+	return std::max(0, coord) / AMBIENT_CELL_SIZE;
+}
+
+static uint32_t CellKey(int cx, int cy)
+{
+	return (uint32_t(cx) << 16) | uint32_t(cy & 0xffff);
+}
+
 AmbientMgr::AmbientMgr()
 {
 	player = std::thread(&AmbientMgr::Play, this);
@@ -44,10 +60,11 @@ AmbientMgr::~AmbientMgr()
 		delete ambientSource;
 	}
 	ambientSources.clear();
+	Reschedule();
 	mutex.unlock();
 	Reset();
 
-	cond.notify_all();
+	WakeUp();
 	player.join();
 }
 
@@ -58,11 +75,67 @@ void AmbientMgr::Reset()
 	AmbientsSet(ambients);
 }
 
-void AmbientMgr::UpdateVolume(unsigned short volume)
+void AmbientMgr::UpdateVolume(unsigned short value)
 {
-	std::lock_guard<std::recursive_mutex> l(mutex);
-	for (const auto& source : ambientSources) {
-		source->SetVolume(volume);
+	volume = value;
+	volumeChanged = true;
+	WakeUp();
+}
+
+void AmbientMgr::WakeUp()
+{
+	{
+		// set under the lock, so the player thread can't miss it between its check and blocking
+		std::lock_guard<std::recursive_mutex> l(mutex);
+		wakeup = true;
+	}
+	cond.notify_all();
+}
+
+bool AmbientMgr::ScheduleCompare(const ScheduleEntry& a, const ScheduleEntry& b)
+{
+	return a.first > b.first; // makes the heap a min-heap
+}
+
+void AmbientMgr::ScheduleSource(AmbientSource* source, tick_t due)
+{
+	source->state = AmbientSource::State::Scheduled;
+	source->due = due;
+	schedule.emplace_back(due, source);
+	std::push_heap(schedule.begin(), schedule.end(), ScheduleCompare);
+}
+
+// rebuilds the schedule after the sources changed, keeping the pending events
+void AmbientMgr::Reschedule()
+{
+	schedule.clear();
+	dormant.clear();
+	cells.clear();
+
+	for (auto source : ambientSources) {
+		const Ambient* ambient = source->GetAmbient();
+		if (!(ambient->GetFlags() & IE_AMBI_MAIN)) {
+			const Point& origin = ambient->GetOrigin();
+			int radius = ambient->GetRadius();
+			int x2 = CellOf(origin.x + radius);
+			int y2 = CellOf(origin.y + radius);
+			for (int x = CellOf(origin.x - radius); x <= x2; ++x) {
+				for (int y = CellOf(origin.y - radius); y <= y2; ++y) {
+					cells[CellKey(x, y)].push_back(source);
+				}
+			}
+		}
+
+		switch (source->state) {
+			case AmbientSource::State::Scheduled:
+				ScheduleSource(source, source->due);
+				break;
+			case AmbientSource::State::Dormant:
+				dormant.push_back(source);
+				break;
+			case AmbientSource::State::Parked:
+				break;
+		}
 	}
 }
 
@@ -76,6 +149,7 @@ void AmbientMgr::AmbientsSet(const std::vector<Ambient*>& a)
 	for (auto& source : a) {
 		ambientSources.push_back(new AmbientSource(source));
 	}
+	Reschedule();
 }
 
 void AmbientMgr::RemoveAmbients(const std::vector<Ambient*> &oldAmbients)
@@ -95,6 +169,7 @@ void AmbientMgr::RemoveAmbients(const std::vector<Ambient*> &oldAmbients)
 		}
 		if (!deleted) ++it;
 	}
+	Reschedule();
 
 	for (auto it = ambients.begin(); it != ambients.end(); ) {
 		bool deleted = false;
@@ -131,14 +206,13 @@ void AmbientMgr::Activate(StringView name)
 			break;
 		}
 	}
-	cond.notify_all();
+	WakeUp();
 }
 
 void AmbientMgr::Activate()
 {
-	std::lock_guard<std::recursive_mutex> l(mutex);
 	active = true;
-	cond.notify_all();
+	WakeUp();
 }
 
 void AmbientMgr::Deactivate(StringView name)
@@ -151,7 +225,7 @@ void AmbientMgr::Deactivate(StringView name)
 			break;
 		}
 	}
-	cond.notify_all();
+	WakeUp();
 }
 
 void AmbientMgr::Deactivate()
@@ -186,15 +260,26 @@ int AmbientMgr::Play()
 		tick_t time = GetMilliseconds();
 		tick_t delay = Tick(time);
 		assert(delay > 0);
-		cond.wait_for(l, std::chrono::milliseconds(delay));
+		cond.wait_for(l, std::chrono::milliseconds(delay), [this]() {
+			return wakeup || !playing;
+		});
+		wakeup = false;
 	}
 	return 0;
 }
 
-tick_t AmbientMgr::Tick(tick_t ticks) const
+tick_t AmbientMgr::Tick(tick_t ticks)
 {
 	tick_t delay = 60000; // wait one minute if all sources are off
 
+	std::lock_guard<std::recursive_mutex> l(mutex);
+	if (volumeChanged) {
+		volumeChanged = false;
+		for (const auto& source : ambientSources) {
+			source->SetVolume(volume);
+		}
+	}
+
 	if (!active) {
 		return delay;
 	}
@@ -207,10 +292,49 @@ tick_t AmbientMgr::Tick(tick_t ticks) const
 		timeslice = SCHEDULE_MASK(game->GameTime);
 	}
 
-	std::lock_guard<std::recursive_mutex> l(mutex);
-	for (auto source : ambientSources) {
+	// scripts and the time of day can enable dormant sources again
+	for (size_t i = 0; i < dormant.size();) {
+		if (dormant[i]->IsEnabled(timeslice)) {
+			ScheduleSource(dormant[i], ticks);
+			dormant[i] = dormant.back();
+			dormant.pop_back();
+		} else {
+			++i;
+		}
+	}
+
+	// parked sources only need a look when the listener is in their vicinity
+	auto cell = cells.find(CellKey(CellOf(listener.x), CellOf(listener.y)));
+	if (cell != cells.end()) {
+		for (auto source : cell->second) {
+			if (source->state == AmbientSource::State::Parked && source->IsHeard(listener)) {
+				ScheduleSource(source, ticks);
+			}
+		}
+	}
+
+	while (!schedule.empty() && schedule.front().first <= ticks) {
+		std::pop_heap(schedule.begin(), schedule.end(), ScheduleCompare);
+		AmbientSource* source = schedule.back().second;
+		schedule.pop_back();
+
 		tick_t newdelay = source->Tick(ticks, listener, timeslice);
-		if (newdelay < delay) delay = newdelay;
+		if (newdelay == std::numeric_limits<tick_t>::max()) {
+			source->state = AmbientSource::State::Dormant;
+			dormant.push_back(source);
+		} else if (!(source->GetAmbient()->GetFlags() & IE_AMBI_MAIN) && !source->IsHeard(listener)) {
+			source->state = AmbientSource::State::Parked;
+		} else {
+			ScheduleSource(source, ticks + newdelay);
+		}
+	}
+
+	if (!schedule.empty()) {
+		delay = std::min(delay, schedule.front().first - ticks);
+	}
+	// any positional source could be parked
+	if (!dormant.empty() || !cells.empty()) {
+		delay = std::min(delay, AMBIENT_RECHECK_DELAY);
 	}
 	return delay;
 }
@@ -317,6 +441,11 @@ tick_t AmbientMgr::AmbientSource::Enqueue() const
 	return core->GetAudioDrv()->QueueAmbient(stream, ambient->sounds[nextref]);
 }
 
+bool AmbientMgr::AmbientSource::IsEnabled(ieDword timeslice) const
+{
+	return !ambient->sounds.empty() && (ambient->GetFlags() & IE_AMBI_ENABLED) && (ambient->GetAppearance() & timeslice);
+}
+
 bool AmbientMgr::AmbientSource::IsHeard(const Point &listener) const
 {
 	return Distance(listener, ambient->GetOrigin()) <= ambient->GetRadius();
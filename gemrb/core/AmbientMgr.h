@@ -30,6 +30,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
@@ -64,6 +65,10 @@ private:
 	std::thread player;
 	std::condition_variable_any cond;
 	std::atomic_bool playing {true};
+	std::atomic_bool wakeup {false};
+	// volume changes are applied by the player thread, so the caller doesn't have to wait for it
+	std::atomic<unsigned short> volume {100};
+	std::atomic_bool volumeChanged {false};
 
 	class AmbientSource {
 	public:
@@ -75,6 +80,16 @@ private:
 		void HardStop();
 		void SetVolume(unsigned short volume) const;
 		const Ambient* GetAmbient() const { return ambient; };
+		bool IsEnabled(ieDword timeslice) const;
+		bool IsHeard(const Point &listener) const;
+
+		enum class State {
+			Scheduled, // waiting for its next event in the schedule
+			Dormant, // disabled or outside its time of day
+			Parked // out of the listener's range
+		};
+		State state = State::Scheduled;
+		tick_t due = 0;
 	private:
 		int stream = -1;
 		const Ambient* ambient;
@@ -83,14 +98,25 @@ private:
 		size_t nextref = 0;
 		unsigned int totalgain = 0;
 
-		bool IsHeard(const Point &listener) const;
 		tick_t Enqueue() const;
 	};
 	std::vector<AmbientSource*> ambientSources;
 
+	// only the sources with an upcoming event are scheduled (a min-heap on the due ticks)
+	// the rest is rechecked cheaply: dormant ones for being enabled again and
+	// parked ones only when their range covers the listener's cell
+	using ScheduleEntry = std::pair<tick_t, AmbientSource*>;
+	std::vector<ScheduleEntry> schedule;
+	std::vector<AmbientSource*> dormant;
+	std::unordered_map<uint32_t, std::vector<AmbientSource*>> cells;
+
 	int Play();
-	tick_t Tick(tick_t ticks) const;
+	tick_t Tick(tick_t ticks);
 	void HardStop() const;
+	void Reschedule();
+	void ScheduleSource(AmbientSource* source, tick_t due);
+	void WakeUp();
+	static bool ScheduleCompare(const ScheduleEntry& a, const ScheduleEntry& b);
 };
 
 }
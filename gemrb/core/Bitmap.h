@@ -21,6 +21,10 @@
 
 #include "Region.h"
 
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
 namespace GemRB {
 
 class GEM_EXPORT Bitmap final
@@ -148,6 +152,23 @@ public:
 	void fill(uint8_t pattern) noexcept {
 		std::fill(begin(), end(), pattern);
 	}
+
+	// ORs the bytes [first, last] of an equally sized bitmap into this one
+	void Merge(const Bitmap& other, int first, int last) noexcept {
+		assert(other.bytes == bytes && first >= 0 && last < bytes);
+		int i = first;
+		for (; i + 8 <= last + 1; i += 8) {
+			uint64_t word;
+			uint64_t otherWord;
+			memcpy(&word, data + i, sizeof(word));
+			memcpy(&otherWord, other.data + i, sizeof(otherWord));
+			word |= otherWord;
+			memcpy(data + i, &word, sizeof(word));
+		}
+		for (; i <= last; ++i) {
+			data[i] |= other.data[i];
+		}
+	}
 };
 
 }
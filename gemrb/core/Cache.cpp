@@ -80,6 +80,8 @@ void Cache::RemoveAll(ReleaseFun fun)
 
 	m_nCount = 0;
 	m_pFreeList = NULL;
+	m_pRetainedHead = m_pRetainedTail = nullptr;
+	m_stats.retainedBytes = 0;
 
 	// free memory blocks
 	MemBlock* p = m_pBlocks;
@@ -125,11 +127,15 @@ Cache::MyAssoc* Cache::NewAssoc()
 	pAssoc->data = 0;
 #endif
 	pAssoc->nRefCount=1;
+	pAssoc->bRetained = false;
 	return pAssoc;
 }
 
 void Cache::FreeAssoc(Cache::MyAssoc* pAssoc)
 {
+	if (pAssoc->bRetained) {
+		Unretain(pAssoc);
+	}
 	if(pAssoc->pNext) {
 		pAssoc->pNext->pPrev=pAssoc->pPrev;
 	}
@@ -192,13 +198,34 @@ Cache::MyAssoc* Cache::GetAssocAt(const ResRef& key) const
 	return NULL;
 }
 
-void *Cache::GetResource(const ResRef& key) const
+Cache::MyAssoc* Cache::FindAssoc(const void* data, const ResRef& key) const
+{
+	if (!key.IsEmpty()) {
+		Cache::MyAssoc* pAssoc = GetAssocAt(key);
+		return (pAssoc && pAssoc->data == data) ? pAssoc : nullptr;
+	}
+
+	for (Cache::MyAssoc* pAssoc = GetNextAssoc(nullptr); pAssoc; pAssoc = GetNextAssoc(pAssoc)) {
+		if (pAssoc->data == data) {
+			return pAssoc;
+		}
+	}
+	return nullptr;
+}
+
+void *Cache::GetResource(const ResRef& key)
 {
 	Cache::MyAssoc* pAssoc = GetAssocAt( key );
 	if (pAssoc == NULL) {
+		m_stats.misses++;
 		return NULL;
 	} // not in map
 
+	m_stats.hits++;
+	if (pAssoc->bRetained) {
+		m_stats.revived++;
+		Unretain(pAssoc);
+	}
 	pAssoc->nRefCount++;
 	return pAssoc->data;
 }
@@ -245,41 +272,84 @@ int Cache::RefCount(const ResRef& key) const
 
 int Cache::DecRef(const void *data, const ResRef& key, bool remove)
 {
-	Cache::MyAssoc* pAssoc;
+	Cache::MyAssoc* pAssoc = FindAssoc(data, key);
+	if (!pAssoc || !pAssoc->nRefCount) {
+		return -1;
+	}
 
-	if (!key.IsEmpty()) {
-		pAssoc=GetAssocAt( key );
-		if (pAssoc && (pAssoc->data==data) ) {
-			if (!pAssoc->nRefCount) {
-				return -1;
-			}
-			--pAssoc->nRefCount;
-			if (remove && !pAssoc->nRefCount) {
-				FreeAssoc(pAssoc);
-				return 0;
-			}
-			return pAssoc->nRefCount;
-		}
+	--pAssoc->nRefCount;
+	if (remove && !pAssoc->nRefCount) {
+		FreeAssoc(pAssoc);
+		return 0;
+	}
+	return pAssoc->nRefCount;
+}
+
+int Cache::Release(const void *data, const ResRef& key, size_t size)
+{
+	Cache::MyAssoc* pAssoc = FindAssoc(data, key);
+	if (!pAssoc || !pAssoc->nRefCount) {
 		return -1;
 	}
 
-	pAssoc = GetNextAssoc(nullptr);
+	if (--pAssoc->nRefCount) {
+		return pAssoc->nRefCount;
+	}
+	Retain(pAssoc, size);
+	TrimRetained();
+	return 0;
+}
 
-	while (pAssoc) {
-		if (pAssoc->data == data) {
-			if (!pAssoc->nRefCount) {
-				return -1;
-			}
-			--pAssoc->nRefCount;
-			if (remove && !pAssoc->nRefCount) {
-				FreeAssoc(pAssoc);
-				return 0;
-			}
-			return pAssoc->nRefCount;
+void Cache::SetRetention(size_t budget, ReleaseFun fun)
+{
+	m_nRetentionBudget = budget;
+	m_pReleaseFun = fun;
+	TrimRetained();
+}
+
+void Cache::Retain(Cache::MyAssoc* pAssoc, size_t size)
+{
+	assert(!pAssoc->bRetained);
+	pAssoc->bRetained = true;
+	pAssoc->nRetainedSize = size;
+	pAssoc->pRetainedPrev = nullptr;
+	pAssoc->pRetainedNext = m_pRetainedHead;
+	if (m_pRetainedHead) {
+		m_pRetainedHead->pRetainedPrev = pAssoc;
+	} else {
+		m_pRetainedTail = pAssoc;
+	}
+	m_pRetainedHead = pAssoc;
+	m_stats.retainedBytes += size;
+}
+
+void Cache::Unretain(Cache::MyAssoc* pAssoc)
+{
+	assert(pAssoc->bRetained);
+	if (pAssoc->pRetainedPrev) {
+		pAssoc->pRetainedPrev->pRetainedNext = pAssoc->pRetainedNext;
+	} else {
+		m_pRetainedHead = pAssoc->pRetainedNext;
+	}
+	if (pAssoc->pRetainedNext) {
+		pAssoc->pRetainedNext->pRetainedPrev = pAssoc->pRetainedPrev;
+	} else {
+		m_pRetainedTail = pAssoc->pRetainedPrev;
+	}
+	pAssoc->bRetained = false;
+	m_stats.retainedBytes -= pAssoc->nRetainedSize;
+}
+
+void Cache::TrimRetained()
+{
+	while (m_pRetainedTail && m_stats.retainedBytes > m_nRetentionBudget) {
+		void* data = m_pRetainedTail->data;
+		FreeAssoc(m_pRetainedTail);
+		if (m_pReleaseFun) {
+			m_pReleaseFun(data);
 		}
-		pAssoc=GetNextAssoc(pAssoc);
+		m_stats.evicted++;
 	}
-	return -1;
 }
 
 void Cache::Cleanup()
@@ -290,7 +360,12 @@ void Cache::Cleanup()
 	{
 		Cache::MyAssoc* nextAssoc = GetNextAssoc(pAssoc);
 		if (pAssoc->nRefCount == 0) {
+			// retained data is owned by the cache
+			void* data = pAssoc->bRetained ? pAssoc->data : nullptr;
 			FreeAssoc(pAssoc);
+			if (data && m_pReleaseFun) {
+				m_pReleaseFun(data);
+			}
 		}
 		pAssoc=nextAssoc;
 	}
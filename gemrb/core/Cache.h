@@ -39,12 +39,25 @@ protected:
 		ResRef key;
 		ieDword nRefCount;
 		void* data;
+		// retention list links, only valid while bRetained is set
+		MyAssoc* pRetainedPrev;
+		MyAssoc* pRetainedNext;
+		size_t nRetainedSize;
+		bool bRetained;
 	};
 	struct MemBlock {
 		MemBlock* pNext;
 	};
 
 public:
+	struct Stats {
+		unsigned long hits = 0;
+		unsigned long misses = 0;
+		unsigned long revived = 0; // hits on retained, unreferenced data
+		unsigned long evicted = 0;
+		size_t retainedBytes = 0;
+	};
+
 	// Construction
 	explicit Cache(int nBlockSize = 10, int nHashTableSize = 129);
 	Cache(const Cache&) = delete;
@@ -61,13 +74,21 @@ public:
 	{
 		return m_nCount==0;
 	}
+	inline const Stats& GetStats() const
+	{
+		return m_stats;
+	}
 	// Lookup
-	void *GetResource(const ResRef& key) const;
+	void *GetResource(const ResRef& key);
 	// Operations
 	bool SetAt(const ResRef& key, void *rValue);
 	// decreases refcount or drops data
 	//if name is supplied it is faster, it will use rValue to validate the request
 	int DecRef(const void *rValue, const ResRef& name, bool free);
+	// like DecRef, but unreferenced data is kept in a LRU list of up to budget bytes
+	// instead of being dropped, and eventually destroyed with the retention release function
+	int Release(const void *rValue, const ResRef& name, size_t size);
+	void SetRetention(size_t budget, ReleaseFun fun);
 	int RefCount(const ResRef& key) const;
 	void RemoveAll(ReleaseFun fun);//removes all refcounts
 	void Cleanup();  //removes only zero refcounts
@@ -82,10 +103,21 @@ protected:
 	MemBlock* m_pBlocks = nullptr;
 	int m_nBlockSize;
 
+	// most recently released first
+	MyAssoc* m_pRetainedHead = nullptr;
+	MyAssoc* m_pRetainedTail = nullptr;
+	size_t m_nRetentionBudget = 0;
+	ReleaseFun m_pReleaseFun = nullptr;
+	Stats m_stats;
+
 	Cache::MyAssoc* NewAssoc();
 	void FreeAssoc(Cache::MyAssoc*);
 	Cache::MyAssoc* GetAssocAt(const ResRef&) const;
+	Cache::MyAssoc* FindAssoc(const void* data, const ResRef& key) const;
 	Cache::MyAssoc *GetNextAssoc(Cache::MyAssoc * rNextPosition) const;
+	void Retain(Cache::MyAssoc*, size_t size);
+	void Unretain(Cache::MyAssoc*);
+	void TrimRetained();
 };
 
 }
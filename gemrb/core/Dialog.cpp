@@ -53,22 +53,18 @@ void Dialog::FreeDialogState(DialogState* ds)
 		for (auto& action : trans->actions) {
 			action->Release();
 		}
-		if (trans->condition)
-			delete trans->condition;
 		delete trans;
 	}
 	free( ds->transitions );
-	if (ds->condition) {
-		delete ds->condition;
-	}
 	delete ds;
 }
 
 int Dialog::FindFirstState(Scriptable* target) const
 {
+	// most states are rejected by their variable checks alone, so try those first
 	for (unsigned int i = 0; i < TopLevelCount; i++) {
-		const Condition *cond = GetState(Order[i])->condition;
-		if (cond && cond->Evaluate(target)) {
+		const Condition *cond = GetState(Order[i])->condition.get();
+		if (cond && cond->Prefilter(target) && cond->Evaluate(target)) {
 			return Order[i];
 		}
 	}
@@ -81,14 +77,14 @@ int Dialog::FindRandomState(Scriptable* target) const
 	if (!max) return -1;
 	unsigned int pick = RAND(0u, max-1);
 	for (unsigned int i = pick; i < max; i++) {
-		const Condition *cond = GetState(i)->condition;
-		if (cond && cond->Evaluate(target)) {
+		const Condition *cond = GetState(i)->condition.get();
+		if (cond && cond->Prefilter(target) && cond->Evaluate(target)) {
 			return i;
 		}
 	}
 	for (unsigned int i = 0; i < pick; i++) {
-		const Condition *cond = GetState(i)->condition;
-		if (cond && cond->Evaluate(target)) {
+		const Condition *cond = GetState(i)->condition.get();
+		if (cond && cond->Prefilter(target) && cond->Evaluate(target)) {
 			return i;
 		}
 	}
@@ -25,6 +25,7 @@
 #include "globals.h"
 #include "Resource.h"
 
+#include <memory>
 #include <vector>
 
 namespace GemRB {
@@ -51,7 +52,7 @@ struct DialogTransition {
 	ieDword Flags;
 	ieStrRef textStrRef;
 	ieStrRef journalStrRef;
-	Condition* condition;
+	std::shared_ptr<const Condition> condition; // shared with the importer's cache
 	std::vector<Action*> actions;
 	ResRef Dialog;
 	ieDword stateIndex;
@@ -61,7 +62,7 @@ struct DialogState {
 	ieStrRef StrRef;
 	DialogTransition** transitions;
 	unsigned int transitionsCount;
-	Condition* condition;
+	std::shared_ptr<const Condition> condition; // shared with the importer's cache
 	unsigned int weight;
 };
 
@@ -31,6 +31,7 @@
 #include "GameScript/GSUtils.h" // for DiffCore
 #include "Interface.h"
 #include "Map.h"
+#include "Profiler.h"
 #include "SymbolMgr.h"
 #include "Scriptable/Actor.h"
 #include "Spell.h" //needs for the source flags bitfield
@@ -450,6 +451,7 @@ bool EffectQueue::RemoveEffect(const Effect* fx)
 //... but some require reinitialisation
 void EffectQueue::ApplyAllEffects(Actor* target)
 {
+	PROFILE_SCOPE(Effects);
 	const auto& Opcodes = Globals::Get().Opcodes;
 
 	for (auto& fx : effects) {
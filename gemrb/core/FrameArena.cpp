@@ -0,0 +1,101 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "FrameArena.h"
+
+#include "Logging/Logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace GemRB {
+
+// enough for a typical frame, bigger needs make the arena grow
+static const size_t FRAME_ARENA_BLOCK_SIZE = 64 * 1024;
+
+FrameArena& FrameArena::Get() noexcept
+{
+	static FrameArena arena;
+	return arena;
+}
+
+void FrameArena::AddBlock(size_t minSize)
+{
+	size_t size = std::max(minSize, FRAME_ARENA_BLOCK_SIZE);
+	blocks.push_back({ std::unique_ptr<char[]>(new char[size]), size });
+	offset = 0;
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment)
+{
+	assert(alignment && (alignment & (alignment - 1)) == 0);
+	if (blocks.empty()) {
+		AddBlock(bytes + alignment);
+	}
+
+	// align the actual address, new char[] only guarantees the fundamental alignment
+	auto base = reinterpret_cast<uintptr_t>(blocks.back().data.get());
+	size_t start = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+	if (start + bytes > blocks.back().size) {
+		AddBlock(bytes + alignment);
+		base = reinterpret_cast<uintptr_t>(blocks.back().data.get());
+		start = ((base + alignment - 1) & ~(alignment - 1)) - base;
+	}
+
+	used += start + bytes - offset;
+	offset = start + bytes;
+	return blocks.back().data.get() + start;
+}
+
+void FrameArena::Deallocate(void* ptr, size_t bytes) noexcept
+{
+	if (blocks.empty()) return;
+
+	const char* end = blocks.back().data.get() + offset;
+	if (static_cast<const char*>(ptr) + bytes == end) {
+		offset -= bytes;
+		used -= bytes;
+	}
+}
+
+void FrameArena::Reset()
+{
+	if (used > peak) {
+		peak = used;
+#ifndef NDEBUG
+		Log(DEBUG, "FrameArena", "New peak usage: {} bytes in {} block(s)", peak, blocks.size());
+#endif
+	}
+
+	if (blocks.size() > 1) {
+		// this frame needed more than one block, so replace them with a single one that fits it all
+		size_t total = 0;
+		for (const auto& block : blocks) {
+			total += block.size;
+		}
+		blocks.clear();
+		AddBlock(total);
+	}
+	offset = 0;
+	used = 0;
+}
+
+}
@@ -0,0 +1,112 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+/**
+ * @file FrameArena.h
+ * Declares FrameArena, a bump allocator for objects that only live for the current frame.
+ * @author The GemRB Project
+ */
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include "exports.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * @class FrameArena
+ * Hands out memory by bumping a pointer and frees everything at once when
+ * the main loop starts the next frame. It is meant for the many short lived
+ * containers that queries like Map::GetAllActorsInRadius return, so they
+ * don't churn the global heap. Main thread only.
+ *
+ * Anything allocated here must not be kept beyond the current frame.
+ */
+
+class GEM_EXPORT FrameArena {
+public:
+	static FrameArena& Get() noexcept;
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void* Allocate(size_t bytes, size_t alignment);
+	// only the most recent allocation is actually given back (this helps growing vectors)
+	void Deallocate(void* ptr, size_t bytes) noexcept;
+	// called once per frame by the main loop, invalidates all the memory handed out
+	void Reset();
+
+	size_t Used() const noexcept { return used; }
+	size_t Peak() const noexcept { return peak; }
+
+private:
+	FrameArena() noexcept = default;
+	void AddBlock(size_t minSize);
+
+	struct Block {
+		std::unique_ptr<char[]> data;
+		size_t size;
+	};
+	std::vector<Block> blocks;
+	size_t offset = 0; // into blocks.back()
+	size_t used = 0; // all blocks together
+	size_t peak = 0;
+};
+
+// a std allocator for containers living in the FrameArena
+template <typename T>
+class FrameAllocator {
+public:
+	using value_type = T;
+
+	FrameAllocator() noexcept = default;
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n)
+	{
+		return static_cast<T*>(FrameArena::Get().Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		FrameArena::Get().Deallocate(ptr, n * sizeof(T));
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>&, const FrameAllocator<U>&) noexcept { return true; }
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>&, const FrameAllocator<U>&) noexcept { return false; }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+template <typename T>
+using FrameList = std::list<T, FrameAllocator<T>>;
+
+}
+
+#endif
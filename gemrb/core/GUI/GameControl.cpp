@@ -553,7 +553,7 @@ void GameControl::DrawSelf(const Region& screen, const Region& /*clip*/)
 		const Actor *actor = area->GetActorByGlobalID(trackerID);
 
 		if (actor) {
-			std::vector<Actor*> monsters = area->GetAllActorsInRadius(actor->Pos, GA_NO_DEAD|GA_NO_LOS|GA_NO_UNSCHEDULED, distance);
+			FrameVector<Actor*> monsters = area->GetAllActorsInRadius(actor->Pos, GA_NO_DEAD|GA_NO_LOS|GA_NO_UNSCHEDULED, distance);
 			for (const auto& monster : monsters) {
 				if (monster->IsPartyMember()) continue;
 				if (monster->GetStat(IE_NOTRACKING)) continue;
@@ -26,12 +26,16 @@
 
 #include "Video/Video.h"
 
+#include <algorithm>
 #include <cwctype>
 #include <utility>
 
 
 namespace GemRB {
 
+// how many laid out strings each font remembers
+static constexpr size_t LAYOUT_CACHE_SIZE = 256;
+
 static void BlitGlyphToCanvas(const Glyph& glyph, const Point& p,
 							  ieByte* canvas, const Size& size)
 {
@@ -135,7 +139,16 @@ const Glyph& Font::GlyphAtlasPage::GlyphForChr(ieWord chr) const
 	return blank;
 }
 
-void Font::GlyphAtlasPage::Draw(ieWord chr, const Region& dest, const PrintColors* colors)
+Region Font::GlyphAtlasPage::SegmentForChr(ieWord chr) const
+{
+	auto it = RegionMap.find(chr);
+	if (it != RegionMap.end()) {
+		return it->second;
+	}
+	return Region();
+}
+
+void Font::GlyphAtlasPage::DrawBatch(const std::vector<SpriteBlit>& blits, const PrintColors* colors)
 {
 	// ensure that we have a sprite!
 	if (Sheet == NULL) {
@@ -156,18 +169,17 @@ void Font::GlyphAtlasPage::Draw(ieWord chr, const Region& dest, const PrintColor
 	
 	if (colors) {
 		if (font->background) {
-			SpriteSheet<ieWord>::Draw(chr, dest, BlitFlags::BLENDED | BlitFlags::COLOR_MOD, colors->bg);
+			// the whole run gets its background first and then the inverted foreground on top
+			video->BlitSprites(Sheet, blits, BlitFlags::BLENDED | BlitFlags::COLOR_MOD, colors->bg);
 			// no point in BlitFlags::ADD with black so let's optimize away some blits
 			if (colors->fg != ColorBlack) {
-				std::swap(Sheet, invertedSheet);
-				SpriteSheet<ieWord>::Draw(chr, dest, BlitFlags::ADD | BlitFlags::COLOR_MOD, colors->fg);
-				std::swap(Sheet, invertedSheet);
+				video->BlitSprites(invertedSheet, blits, BlitFlags::ADD | BlitFlags::COLOR_MOD, colors->fg);
 			}
 		} else {
-			SpriteSheet<ieWord>::Draw(chr, dest, BlitFlags::BLENDED | BlitFlags::COLOR_MOD, colors->fg);
+			video->BlitSprites(Sheet, blits, BlitFlags::BLENDED | BlitFlags::COLOR_MOD, colors->fg);
 		}
 	} else {
-		SpriteSheet<ieWord>::Draw(chr, dest, BlitFlags::BLENDED, ColorWhite);
+		video->BlitSprites(Sheet, blits, BlitFlags::BLENDED, ColorWhite);
 	}
 }
 
@@ -200,7 +212,7 @@ void Font::CreateGlyphIndex(ieWord chr, ieWord pageIdx, const Glyph* g)
 	} else {
 		assert(AtlasIndex[chr].pageIdx == static_cast<ieWord>(-1));
 	}
-	AtlasIndex[chr] = GlyphIndexEntry(chr, pageIdx, g);
+	AtlasIndex[chr] = GlyphIndexEntry(chr, pageIdx, g, Atlas[pageIdx]->SegmentForChr(chr));
 }
 
 const Glyph& Font::CreateGlyphForCharSprite(ieWord chr, const Holder<Sprite2D>& spr)
@@ -236,8 +248,10 @@ void Font::CreateAliasForChar(ieWord chr, ieWord alias)
 	// we need to now find the page for the existing character and add this new one to that page
 	const GlyphIndexEntry& idx = AtlasIndex[chr]; // this referenece may become invalid after call to CreateGlyphIndex!
 	ieWord pageIdx = idx.pageIdx;
-	CreateGlyphIndex(alias, pageIdx, idx.glyph);
+	const Glyph* glyph = idx.glyph;
+	// map the segment first, so the index entry can pick it up
 	Atlas[pageIdx]->MapSheetSegment(alias, (*Atlas[pageIdx])[chr]);
+	CreateGlyphIndex(alias, pageIdx, glyph);
 }
 
 const Glyph& Font::GetGlyph(ieWord chr) const
@@ -252,7 +266,7 @@ const Glyph& Font::GetGlyph(ieWord chr) const
 	return blank;
 }
 
-size_t Font::RenderText(const String& string, Region& rgn, ieByte alignment, const PrintColors* colors,
+size_t Font::RenderText(const String& string, Region& rgn, ieByte alignment, TextLayout* layout,
 						Point* point, ieByte** canvas, bool grow) const
 {
 	// NOTE: vertical alignment is not handled here.
@@ -355,7 +369,7 @@ size_t Font::RenderText(const String& string, Region& rgn, ieByte alignment, con
 					core->GetVideoDriver()->DrawRect(Region(linePoint + lineRgn.origin,
 												 Size(lineSize.w, LineHeight)), ColorWhite, false);
 				}
-				linePos = RenderLine(line, lineRgn, linePoint, colors, canvas);
+				linePos = RenderLine(line, lineRgn, linePoint, layout, canvas);
 			}
 			if (linePos == 0) {
 				break; // if linePos == 0 then we would loop till we are out of bounds so just stop here
@@ -408,7 +422,7 @@ size_t Font::RenderText(const String& string, Region& rgn, ieByte alignment, con
 }
 
 size_t Font::RenderLine(const String& line, const Region& lineRgn,
-						Point& dp, const PrintColors* colors, ieByte** canvas) const
+						Point& dp, TextLayout* layout, ieByte** canvas) const
 {
 	assert(lineRgn.h == LineHeight);
 
@@ -472,10 +486,9 @@ size_t Font::RenderLine(const String& line, const Region& lineRgn,
 
 			if (canvas) {
 				BlitGlyphToCanvas(curGlyph, blitPoint, *canvas, lineRgn.size);
-			} else {
-				size_t pageIdx = AtlasIndex[currChar].pageIdx;
-				GlyphAtlasPage* page = Atlas[pageIdx];
-				page->Draw(currChar, Region(blitPoint, curGlyph.size), colors);
+			} else if (layout && ieWord(currChar) < AtlasIndex.size()) {
+				const GlyphIndexEntry& entry = AtlasIndex[currChar];
+				layout->glyphs.push_back({ entry.pageIdx, entry.segment, Region(blitPoint, curGlyph.size) });
 			}
 			dp.x += curGlyph.size.w;
 		}
@@ -572,11 +585,8 @@ size_t Font::Print(const Region& rgn, const String& string, ieByte alignment, co
 	return Print(rgn, string, alignment, &colors, point);
 }
 
-size_t Font::Print(Region rgn, const String& string, ieByte alignment, const PrintColors* colors, Point* point) const
+size_t Font::LayoutText(Region rgn, const String& string, ieByte alignment, TextLayout& layout, Point& p) const
 {
-	if (rgn.size.IsInvalid()) return 0;
-
-	Point p = point ? *point : Point();
 	if (alignment&(IE_FONT_ALIGN_MIDDLE|IE_FONT_ALIGN_BOTTOM)) {
 		// we assume that point will be an offset from midde/bottom position
 		Size stringSize;
@@ -602,12 +612,84 @@ size_t Font::Print(Region rgn, const String& string, ieByte alignment, const Pri
 		}
 	}
 
-	size_t ret = RenderText(string, rgn, alignment, colors, &p);
+	return RenderText(string, rgn, alignment, &layout, &p);
+}
 
+void Font::DrawLayout(const TextLayout& layout, const Point& origin, const PrintColors* colors) const
+{
+	// one batch per atlas page, most strings only need a single one
+	std::vector<ieWord> pages;
+	for (const auto& glyph : layout.glyphs) {
+		if (std::find(pages.begin(), pages.end(), glyph.pageIdx) == pages.end()) {
+			pages.push_back(glyph.pageIdx);
+		}
+	}
+
+	std::vector<SpriteBlit> blits;
+	blits.reserve(layout.glyphs.size());
+	for (ieWord pageIdx : pages) {
+		blits.clear();
+		for (const auto& glyph : layout.glyphs) {
+			if (glyph.pageIdx != pageIdx || glyph.segment.size.IsInvalid()) continue;
+			Region dest = glyph.dest;
+			dest.x += origin.x;
+			dest.y += origin.y;
+			blits.push_back({ glyph.segment, dest });
+		}
+		if (!blits.empty()) {
+			Atlas[pageIdx]->DrawBatch(blits, colors);
+		}
+	}
+}
+
+size_t Font::Print(Region rgn, const String& string, ieByte alignment, const PrintColors* colors, Point* point) const
+{
+	if (rgn.size.IsInvalid()) return 0;
+
+	Point p = point ? *point : Point();
+	const Region& sclip = core->GetVideoDriver()->GetScreenClip();
+	if (core->InDebugMode(ID_FONTS) || !sclip.IntersectsRegion(rgn)) {
+		// offscreen text isn't laid out at all and the debug mode draws while doing so
+		TextLayout layout;
+		size_t ret = LayoutText(rgn, string, alignment, layout, p);
+		DrawLayout(layout, Point(), colors);
+		if (point) {
+			*point = p;
+		}
+		return ret;
+	}
+
+	LayoutKey key { string, rgn.size, p, alignment };
+	auto it = layoutCache.find(key);
+	if (it == layoutCache.end()) {
+		if (layoutCache.size() >= LAYOUT_CACHE_SIZE) {
+			layoutCache.clear();
+		}
+		TextLayout layout;
+		layout.charCount = LayoutText(rgn, string, alignment, layout, p);
+		layout.endPoint = p;
+		for (auto& glyph : layout.glyphs) {
+			glyph.dest.x -= rgn.x;
+			glyph.dest.y -= rgn.y;
+		}
+		it = layoutCache.emplace(std::move(key), std::move(layout)).first;
+	}
+
+	const TextLayout& layout = it->second;
+	DrawLayout(layout, rgn.origin, colors);
 	if (point) {
-		*point = p;
+		*point = layout.endPoint;
 	}
-	return ret;
+	return layout.charCount;
+}
+
+size_t Font::LayoutKeyHash::operator()(const LayoutKey& key) const noexcept
+{
+	size_t hash = std::hash<String>()(key.text);
+	hash ^= size_t(key.size.w) * 31 + size_t(key.size.h) * 131071;
+	hash ^= (size_t(key.start.x) * 8191 + size_t(key.start.y) * 524287) << 1;
+	hash ^= size_t(key.alignment) << 3;
+	return hash;
 }
 
 size_t Font::StringSizeWidth(const String& string, size_t width, size_t* numChars) const
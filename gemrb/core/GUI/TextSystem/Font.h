@@ -40,6 +40,8 @@
 
 #include <deque>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace GemRB {
 
@@ -130,10 +132,10 @@ private:
 			}
 		bool AddGlyph(ieWord chr, const Glyph& g);
 		const Glyph& GlyphForChr(ieWord chr) const;
+		Region SegmentForChr(ieWord chr) const;
 
-		// we need a non-const version of Draw here that will call the base const version
-		using SpriteSheet<ieWord>::Draw;
-		void Draw(ieWord chr, const Region& dest, const PrintColors* colors);
+		// draws a run of glyphs from this page, src being their sheet segments
+		void DrawBatch(const std::vector<SpriteBlit>& blits, const PrintColors* colors);
 		void DumpToScreen(const Region&) const;
 	};
 
@@ -141,9 +143,37 @@ private:
 		ieWord chr = 0;
 		ieWord pageIdx = -1;
 		const Glyph* glyph = nullptr;
+		Region segment; // where the glyph is on its page
 
 		GlyphIndexEntry() noexcept = default;
-		GlyphIndexEntry(ieWord c, ieWord p, const Glyph* g) : chr(c), pageIdx(p), glyph(g) {}
+		GlyphIndexEntry(ieWord c, ieWord p, const Glyph* g, const Region& s) : chr(c), pageIdx(p), glyph(g), segment(s) {}
+	};
+
+	// a laid out string, ready to be drawn again
+	struct TextLayout {
+		struct PlacedGlyph {
+			ieWord pageIdx;
+			Region segment;
+			Region dest; // relative to the print region
+		};
+		std::vector<PlacedGlyph> glyphs;
+		size_t charCount = 0;
+		Point endPoint;
+	};
+
+	struct LayoutKey {
+		String text;
+		Size size;
+		Point start;
+		ieByte alignment;
+
+		bool operator==(const LayoutKey& other) const noexcept {
+			return alignment == other.alignment && size == other.size && start == other.start && text == other.text;
+		}
+	};
+
+	struct LayoutKeyHash {
+		size_t operator()(const LayoutKey& key) const noexcept;
 	};
 
 	using GlyphIndex = std::vector<GlyphIndexEntry>;
@@ -155,6 +185,9 @@ private:
 	GlyphIndex AtlasIndex;
 	GlyphAtlas Atlas;
 
+	// labels, buttons and text spans print the same strings every frame
+	mutable std::unordered_map<LayoutKey, TextLayout, LayoutKeyHash> layoutCache;
+
 protected:
 	PaletteHolder palette;
 	bool background = false;
@@ -165,12 +198,14 @@ public:
 
 private:
 	void CreateGlyphIndex(ieWord chr, ieWord pageIdx, const Glyph*);
-	// Blit to the sprite or screen if canvas is NULL
-	size_t RenderText(const String&, Region&, ieByte alignment, const PrintColors*,
+	// Blit to the sprite or lay out for the screen if canvas is NULL
+	size_t RenderText(const String&, Region&, ieByte alignment, TextLayout*,
 					  Point* = NULL, ieByte** canvas = NULL, bool grow = false) const;
 	// render a single line of text. called by RenderText()
 	size_t RenderLine(const String& string, const Region& rgn,
-					  Point& dp, const PrintColors*, ieByte** canvas = NULL) const;
+					  Point& dp, TextLayout*, ieByte** canvas = NULL) const;
+	size_t LayoutText(Region rgn, const String& string, ieByte Alignment, TextLayout& layout, Point& p) const;
+	void DrawLayout(const TextLayout& layout, const Point& origin, const PrintColors* colors) const;
 	
 	size_t Print(Region rgn, const String& string, ieByte Alignment, const PrintColors* colors, Point* point = nullptr) const;
 
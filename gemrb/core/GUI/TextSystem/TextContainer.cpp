@@ -362,13 +362,12 @@ void ContentContainer::DrawSelf(const Region& drawFrame, const Region& clip)
 	// layout shouldn't be empty unless there is no content anyway...
 	if (layout.empty()) return;
 	Point dp = drawFrame.origin + Point(margin.left, margin.top);
-	
-	ContentLayout::const_iterator it = layout.begin();
-	for (; it != layout.end(); ++it) {
-		const Layout& l = *it;
 
-		// TODO: pass the clip rect so we can skip non-intersecting regions
-		DrawContents(l, dp);
+	// only draw what intersects the clip, long logs are mostly scrolled out of view
+	int bottom = clip.y + clip.h - dp.y;
+	ContentLayout::const_iterator it = FirstLayoutBelow(clip.y - dp.y);
+	for (; it != layout.end() && it->Top() < bottom; ++it) {
+		DrawContents(*it, dp);
 	}
 }
 
@@ -379,10 +378,10 @@ void ContentContainer::DrawContents(const Layout& contentLayout, Point point)
 
 void ContentContainer::AppendContent(Content* content)
 {
-	if (contents.empty())
-		InsertContentAfter(content, NULL);
-	else
-		InsertContentAfter(content, *(--contents.end()));
+	// no need to search for the insertion point like InsertContentAfter
+	content->parent = this;
+	contents.push_back(content);
+	LayoutContentsFrom(--contents.end());
 }
 
 void ContentContainer::InsertContentAfter(Content* newContent, const Content* existing)
@@ -530,18 +529,29 @@ Region ContentContainer::BoundingBoxForLayout(const LayoutRegions& layoutRgns) c
 
 const ContentContainer::Layout& ContentContainer::LayoutForContent(const Content* c) const
 {
-	ContentLayout::const_iterator it = std::find(layout.begin(), layout.end(), c);
-	if (it != layout.end()) {
+	// search backwards, we are mostly asked about the content that was just appended
+	ContentLayout::const_reverse_iterator it = std::find(layout.rbegin(), layout.rend(), c);
+	if (it != layout.rend()) {
 		return *it;
 	}
-	static Layout NullLayout(nullptr, LayoutRegions());
+	static Layout NullLayout(nullptr, LayoutRegions(), 0);
 	return NullLayout;
 }
 
+ContentContainer::ContentLayout::const_iterator ContentContainer::FirstLayoutBelow(int y) const
+{
+	// everything before the result ends at or above y
+	return std::partition_point(layout.begin(), layout.end(), [y](const Layout& l) {
+		return l.extent <= y;
+	});
+}
+
 const Region* ContentContainer::ContentRegionForRect(const Region& r) const
 {
-	for (const auto& layoutRgn : layout) {
-		for (const auto& lrgn : layoutRgn.regions) {
+	int bottom = r.y + r.h;
+	ContentLayout::const_iterator it = FirstLayoutBelow(r.y);
+	for (; it != layout.end() && it->Top() < bottom; ++it) {
+		for (const auto& lrgn : it->regions) {
 			const Region& rect = lrgn->region;
 			if (rect.IntersectsRegion(r)) {
 				return &rect;
@@ -574,14 +584,15 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 	// clear the existing layout, but only for "it" and onward
 	ContentList::const_iterator clearit = it;
 	for (; clearit != contents.end(); ++clearit) {
-		ContentLayout::iterator i = std::find(layout.begin(), layout.end(), *clearit);
-		if (i != layout.end()) {
+		ContentLayout::reverse_iterator i = std::find(layout.rbegin(), layout.rend(), *clearit);
+		if (i != layout.rend()) {
 			layoutPoint.reset(); // reset cached layoutPoint
 			// since 'layout' is sorted alongsize 'contents' we should be able clear everyting following 'i' and bail
-			layout.erase(i, layout.end());
+			layout.erase(std::prev(i.base()), layout.end());
 			break;
 		}
 	}
+	int extent = layout.empty() ? 0 : layout.back().extent;
 
 	Size contentBounds = Dimensions();
 	Region layoutFrame = Region(Point(), contentBounds);
@@ -622,12 +633,13 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 		}
 		const LayoutRegions& rgns = content->LayoutForPointInRegion(layoutPoint, layoutFrame);
 		if (rgns.empty()) return;
-		layout.emplace_back(content, rgns);
+		Region bounds = BoundingBoxForLayout(rgns);
+		extent = std::max(extent, bounds.y + bounds.h);
+		layout.emplace_back(content, rgns, extent);
 		exContent = content;
 
 		ieDword flags = Flags();
 		if (flags&(RESIZE_HEIGHT|RESIZE_WIDTH)) {
-			Region bounds = BoundingBoxForLayout(rgns);
 			bounds.w += margin.left + margin.right;
 			bounds.h += margin.top + margin.bottom;
 			
@@ -650,16 +662,35 @@ void ContentContainer::DeleteContentsInRect(const Region& exclusion)
 	int top = exclusion.y;
 	int bottom = top;
 	const Content* content;
+	// trimming a log removes the leading content, which we track to avoid a full relayout
+	bool leading = true;
+	int removedExtent = 0;
+	Point oldLayoutPoint = layoutPoint;
 	while (const Region* rgn = ContentRegionForRect(exclusion)) {
 		content = ContentAtPoint(rgn->origin);
 		assert(content);
 
 		top = (rgn->y < top) ? rgn->y : top;
 		bottom = (rgn->y + rgn->h > bottom) ? rgn->y + rgn->h : bottom;
+		if (leading && layout.front().content == content) {
+			removedExtent = layout.front().extent;
+		} else {
+			leading = false;
+		}
 		// must delete content last!
 		delete RemoveContent(content, false);
 	}
 
+	// if nothing left was positioned next to what we removed, the rest simply moves up
+	if (leading && removedExtent && !layout.empty()) {
+		const Region& first = layout.front().regions.front()->region;
+		if (first.x == 0 && first.y >= removedExtent && ShiftLayoutUp(first.y)) {
+			layoutPoint = oldLayoutPoint;
+			layoutPoint.y -= first.y;
+			return;
+		}
+	}
+
 	if (Flags()&RESIZE_HEIGHT) {
 		frame.h = 0;
 	}
@@ -670,6 +701,26 @@ void ContentContainer::DeleteContentsInRect(const Region& exclusion)
 	LayoutContentsFrom(contents.begin());
 }
 
+bool ContentContainer::ShiftLayoutUp(int dy)
+{
+	// a fixed height would clip the layout differently and removed content may have been the widest
+	if ((Flags() & (RESIZE_HEIGHT|RESIZE_WIDTH)) != RESIZE_HEIGHT) {
+		return false;
+	}
+
+	for (auto& contentLayout : layout) {
+		// the regions are not shared with anyone else, so we can reuse them in place
+		for (auto& lrgn : contentLayout.regions) {
+			lrgn->region.y -= dy;
+		}
+		contentLayout.extent -= dy;
+	}
+
+	Size oldSize = Dimensions();
+	frame.h = std::max(0, frame.h - dy);
+	ResizeSubviews(oldSize);
+	return true;
+}
 
 TextContainer::TextContainer(const Region& frame, Font* fnt)
 	: ContentContainer(frame), font(fnt)
@@ -748,7 +799,14 @@ String TextContainer::TextFrom(ContentList::const_iterator it) const
 
 void TextContainer::DrawSelf(const Region& drawFrame, const Region& clip)
 {
-	printPos = 0;
+	// only the visible content is drawn, so find the one with the cursor up front
+	cursorContent = nullptr;
+	if (Editable()) {
+		ContentIndex idx = FindContentForChar(cursorPos);
+		if (idx.second != contents.end()) {
+			cursorContent = *idx.second;
+		}
+	}
 	ContentContainer::DrawSelf(drawFrame, clip);
 
 	if (layout.empty() && Editable()) {
@@ -778,9 +836,8 @@ void TextContainer::DrawContents(const Layout& layout, Point dp)
 
 	const TextSpan* ts = (const TextSpan*)layout.content;
 	const String& text = ts->Text();
-	size_t textLength = ts->Text().length();
 
-	if (Editable() && printPos <= cursorPos && printPos + textLength >= cursorPos) {
+	if (layout.content == cursorContent) {
 		const Font* printFont = ts->LayoutFont();
 		
 		auto it = FindCursorRegion(layout);
@@ -797,7 +854,6 @@ void TextContainer::DrawContents(const Layout& layout, Point dp)
 		dp.y += cursor->Frame.y;
 		core->GetVideoDriver()->BlitSprite(cursor, cursorPoint + dp);
 	}
-	printPos += textLength;
 }
 
 void TextContainer::SizeChanged(const Size& oldSize)
@@ -157,12 +157,19 @@ protected:
 	struct Layout {
 		const Content* content;
 		LayoutRegions regions;
+		// the lowest point reached by this or any earlier layout
+		// it never decreases along 'layout', so it doubles as a height index for culling
+		int extent;
 		
-		Layout(const Content* c, LayoutRegions rgns)
-		: content(c), regions(std::move(rgns)) {
+		Layout(const Content* c, LayoutRegions rgns, int extent)
+		: content(c), regions(std::move(rgns)), extent(extent) {
 			assert(!regions.empty());
 		}
 
+		int Top() const {
+			return regions.front()->region.y;
+		}
+
 		bool operator==(const Content* c) const {
 			return c == content;
 		}
@@ -225,6 +232,8 @@ protected:
 
 	const Layout& LayoutForContent(const Content*) const;
 	const Layout* LayoutAtPoint(const Point& p) const;
+	ContentLayout::const_iterator FirstLayoutBelow(int y) const;
+	bool ShiftLayoutUp(int dy);
 
 	void DrawSelf(const Region& drawFrame, const Region& clip) override;
 	virtual void DrawContents(const Layout& contentLayout, Point point);
@@ -249,7 +258,7 @@ private:
 
 	size_t textLen = 0;
 	size_t cursorPos = 0;
-	size_t printPos = 0;
+	const Content* cursorContent = nullptr;
 	Point cursorPoint;
 
 private:
@@ -83,11 +83,9 @@ void View::SetEventProxy(View* proxy)
 // TODO: while GemRB does support nested subviews, it does not (fully) support overlapping subviews (same superview, intersecting frame)
 // expect weird things to happen with them
 // this method takes the dirty region so the framework exists, but currently this just invalidates any intersecting subviews
+// partial damage goes through DirtyBGRect instead, which doesn't dirty the entire view
 void View::MarkDirty(const Region* rgn)
 {
-	// TODO: we could implement partial redraws by storing the dirty region
-	// not much to gain at the moment, however
-
 	if (dirty) return;
 
 	dirty = true;
@@ -119,6 +117,11 @@ void View::MarkDirty()
 }
 
 bool View::NeedsDraw() const
+{
+	return NeedsFullDraw() || (!dirtyBGRects.empty() && !(flags&Invisible));
+}
+
+bool View::NeedsFullDraw() const
 {
 	// cull anything that can't be seen
 	if (frame.size.IsInvalid() || (flags&Invisible)) return false;
@@ -128,13 +131,13 @@ bool View::NeedsDraw() const
 		return true;
 	}
 
-	// else we don't need an update
+	// else we don't need an update (besides the dirty rects)
 	return false;
 }
 
 bool View::NeedsDrawRecursive() const
 {
-	if (NeedsDraw()) {
+	if (NeedsFullDraw()) {
 		return true;
 	}
 	
@@ -175,10 +178,16 @@ void View::DirtyBGRect(const Region& r, bool force) noexcept
 {
 	// no need to draw the parent BG for opaque views
 	if (superView && !IsOpaque()) {
+		// the superview passes the damage back down to us along with any other subviews under it
 		Region rgn = frame.Intersect(Region(ConvertPointToSuper(r.origin), r.size));
 		superView->DirtyBGRect(rgn, force);
+	} else {
+		DamageRect(r, force);
 	}
+}
 
+void View::DamageRect(const Region& r, bool force) noexcept
+{
 	// if we are going to draw the entire BG, no need to compute and store this
 	if (!force && NeedsDrawRecursive())
 		return;
@@ -187,19 +196,44 @@ void View::DirtyBGRect(const Region& r, bool force) noexcept
 	//Region bgRgn = Region(background->Frame.x, background->Frame.y, background->Frame.w, background->Height);
 	Region clip(Point(), Dimensions());
 	Region dirtyRect = r.Intersect(clip);
+	if (dirtyRect.size.IsInvalid()) return;
+
+	// keep the rects disjoint, so translucent content isn't blended twice when repainting them
+	for (auto it = dirtyBGRects.begin(); it != dirtyBGRects.end();) {
+		if (it->IntersectsRegion(dirtyRect)) {
+			dirtyRect = Region::RegionEnclosingRegions(*it, dirtyRect);
+			dirtyBGRects.erase(it);
+			it = dirtyBGRects.begin();
+		} else {
+			++it;
+		}
+	}
 	dirtyBGRects.push_back(dirtyRect);
-	
-	MarkDirty(&dirtyRect);
+
+	// only the parts of subviews over the damage need to be redrawn, not the entire view
+	for (View* subview : subViews) {
+		Region intersect = subview->frame.Intersect(dirtyRect);
+		if (!intersect.size.IsInvalid()) {
+			Point p = subview->ConvertPointFromSuper(intersect.origin);
+			subview->DamageRect(Region(p, intersect.size), force);
+		}
+	}
 }
 
 void View::DrawSubviews()
 {
+	// animated subviews damage us for the next frame, but we can't apply it while drawing the siblings
+	Regions animated;
 	for (View* subview : subViews) {
 		subview->Draw();
 		if (subview->IsAnimated() && !subview->IsOpaque()) {
-			DirtyBGRect(subview->frame, true);
+			animated.push_back(subview->frame);
 		}
 	}
+	for (const Region& r : animated) {
+		// not DamageRect, a translucent container needs its opaque ancestor to repaint the background
+		DirtyBGRect(r, true);
+	}
 }
 
 Region View::DrawingFrame() const
@@ -261,11 +295,19 @@ void View::Draw()
 	if (needsDraw) {
 		DrawBackground(NULL);
 		DrawSelf(drawFrame, intersect);
-	} else {
-		Regions::iterator it = dirtyBGRects.begin();
-		while (it != dirtyBGRects.end()) {
-			DrawBackground(&(*it++));
+	} else if (!dirtyBGRects.empty()) {
+		// partial redraw: only repaint ourselves inside the damaged rects
+		// WillDraw may have changed the clip, so respect that too
+		const Region drawClip = video->GetScreenClip();
+		for (const Region& rgn : dirtyBGRects) {
+			Region dirtyClip = drawClip.Intersect(Region(ConvertPointToWindow(rgn.origin), rgn.size));
+			if (dirtyClip.size.IsInvalid()) continue;
+
+			video->SetScreenClip(&dirtyClip);
+			DrawBackground(&rgn);
+			DrawSelf(drawFrame, dirtyClip);
 		}
+		video->SetScreenClip(&drawClip);
 	}
 
 	dirtyBGRects.clear();
@@ -79,9 +79,8 @@ private:
 
 	mutable bool dirty = true;
 
-	// TODO: we could/should generalize this
-	// MarkDirty could take a region, and more complicated views could potentially
-	// save a lot of drawing time by only drawing their dirty portions (GameControl?)
+	// damaged areas (in our coordinates) to redraw when we aren't dirty as a whole
+	// both the background and DrawSelf are repainted clipped to each of them
 	Regions dirtyBGRects;
 	
 	View* eventProxy = nullptr;
@@ -102,14 +101,15 @@ protected:
 
 private:
 	void DirtyBGRect(const Region&, bool force = false) noexcept;
+	void DamageRect(const Region&, bool force) noexcept;
 	void DrawBackground(const Region*) const;
 	void DrawSubviews();
 	void MarkDirty(const Region*);
+	bool NeedsFullDraw() const;
 	bool NeedsDrawRecursive() const;
 
-	// TODO: to support partial redraws, we should change the clip parameter to a list of dirty rects
-	// that have all been clipped to the video ScreenClip
-	// subclasses can then use the list to efficiently redraw only those sections that are dirty
+	// for partial redraws this is called once per damaged rect, with the clip (and the video ScreenClip) set to it
+	// subclasses can use the clip to skip drawing anything outside of it
 	virtual void DrawSelf(const Region& /*drawFrame*/, const Region& /*clip*/) {};
 	Region DrawingFrame() const;
 
@@ -21,6 +21,7 @@
 #include "GameData.h"
 #include "Interface.h"
 #include "ImageMgr.h"
+#include "Profiler.h"
 #include "Window.h"
 #include "GUI/GameControl.h"
 
@@ -566,6 +567,7 @@ WindowManager::HUDLock WindowManager::DrawHUD() const
 
 void WindowManager::DrawWindows() const
 {
+	PROFILE_SCOPE(Windows);
 	HUDBuf->Clear();
 
 	if (windows.empty()) {
@@ -620,6 +622,8 @@ void WindowManager::DrawWindows() const
 		if (win->IsDisabled() && win->NeedsDraw()) {
 			// Important to only draw if the window itself is dirty
 			// controls on greyed out windows shouldn't be updating anyway
+			// redraw it whole, a partial redraw would darken the untouched parts twice
+			win->MarkDirty();
 			win->Draw();
 			Region winrgn(Point(), win->Dimensions());
 			video->DrawRect(winrgn, ColorBlack, true, BlitFlags::HALFTRANS|BlitFlags::BLENDED);
@@ -33,6 +33,7 @@
 #include "MusicMgr.h"
 #include "Particles.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "ScriptEngine.h"
 #include "Spell.h"
 #include "TableMgr.h"
@@ -1469,6 +1470,7 @@ bool Game::EveryoneDead() const
 
 void Game::UpdateScripts()
 {
+	PROFILE_SCOPE(GameScripts);
 	Update();
 
 	PartyAttack = false;
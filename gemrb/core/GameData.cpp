@@ -41,11 +41,15 @@
 #include "Spell.h"
 #include "SpellMgr.h"
 #include "StoreMgr.h"
+#include "SymbolMgr.h"
 #include "VEFObject.h"
 #include "Scriptable/Actor.h"
 #include "Streams/FileStream.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <thread>
 
 namespace GemRB {
 
@@ -64,20 +68,180 @@ static void ReleaseEffect(void *poi)
 	delete ((Effect *) poi);
 }
 
+// rough heap footprint, used to budget the retained items and spells
+static size_t ItemSize(const Item* itm)
+{
+	size_t size = sizeof(Item) + itm->ext_headers.capacity() * sizeof(ITMExtHeader);
+	size += itm->equipping_features.size() * (sizeof(Effect*) + sizeof(Effect));
+	for (const auto& header : itm->ext_headers) {
+		size += header.features.size() * (sizeof(Effect*) + sizeof(Effect));
+	}
+	return size;
+}
+
+static size_t SpellSize(const Spell* spl)
+{
+	size_t size = sizeof(Spell) + spl->ext_headers.capacity() * sizeof(SPLExtHeader);
+	size += spl->casting_features.capacity() * sizeof(Effect);
+	for (const auto& header : spl->ext_headers) {
+		size += header.features.capacity() * sizeof(Effect);
+	}
+	return size;
+}
+
+static void LogCacheStats(const char* name, const Cache& cache)
+{
+	const Cache::Stats& stats = cache.GetStats();
+	Log(DEBUG, "GameData", "{} cache: {} hits ({} of retained data), {} misses, {} evicted, {} bytes retained",
+		name, stats.hits, stats.revived, stats.misses, stats.evicted, stats.retainedBytes);
+}
+
 GEM_EXPORT GameData* gamedata;
 
+template <typename T>
+static PluginHolder<T> ParseResource(const ResourceManager& resources, const ResRef& ref, SClass_ID type, bool silent)
+{
+	DataStream* str = resources.GetResource(ref, type, silent);
+	if (!str) {
+		return nullptr;
+	}
+	PluginHolder<T> plugin = MakePluginHolder<T>(type);
+	if (!plugin) {
+		delete str;
+		return nullptr;
+	}
+	if (!plugin->Open(str)) {
+		return nullptr;
+	}
+	return plugin;
+}
+
+// the workers only touch their own task, the results are handed over on the main thread
+struct GameData::PrewarmJob {
+	using clock = std::chrono::steady_clock;
+
+	struct Task {
+		ResRef name;
+		SClass_ID type;
+		PluginHolder<TableMgr> table;
+		PluginHolder<SymbolMgr> symbol;
+		clock::duration time;
+	};
+
+	std::vector<Task> tasks;
+	std::atomic<size_t> next {0};
+	std::vector<std::thread> workers;
+	clock::time_point start = clock::now();
+
+	void Work(const ResourceManager& resources)
+	{
+		for (size_t i = next++; i < tasks.size(); i = next++) {
+			Task& task = tasks[i];
+			clock::time_point taskStart = clock::now();
+			if (task.type == IE_2DA_CLASS_ID) {
+				task.table = ParseResource<TableMgr>(resources, task.name, task.type, true);
+			} else {
+				task.symbol = ParseResource<SymbolMgr>(resources, task.name, task.type, true);
+			}
+			task.time = clock::now() - taskStart;
+		}
+	}
+};
+
 GameData::GameData()
 {
 	factory = new Factory();
+	SetRetentionBudget(0);
 }
 
 GameData::~GameData()
 {
+	FinishPrewarm();
 	delete factory;
 }
 
+void GameData::StartPrewarm(const std::vector<ResRef>& tableRefs, const std::vector<ResRef>& symbolRefs)
+{
+	FinishPrewarm();
+	prewarm = std::unique_ptr<PrewarmJob>(new PrewarmJob());
+	for (const auto& ref : tableRefs) {
+		if (!tables.count(ref)) {
+			prewarm->tasks.push_back({ ref, IE_2DA_CLASS_ID, nullptr, nullptr, {} });
+		}
+	}
+	for (const auto& ref : symbolRefs) {
+		if (!prewarmedSymbols.count(ref) && core->GetSymbolIndex(ref) == -1) {
+			prewarm->tasks.push_back({ ref, IE_IDS_CLASS_ID, nullptr, nullptr, {} });
+		}
+	}
+
+	// keep a core for the main thread
+	size_t threads = std::thread::hardware_concurrency();
+	threads = std::min<size_t>(threads > 1 ? threads - 1 : 1, prewarm->tasks.size());
+	for (size_t i = 0; i < threads; ++i) {
+		prewarm->workers.emplace_back(&PrewarmJob::Work, prewarm.get(), std::cref(*this));
+	}
+}
+
+void GameData::FinishPrewarm()
+{
+	if (!prewarm) return;
+
+	using namespace std::chrono;
+	auto waitStart = PrewarmJob::clock::now();
+	for (auto& worker : prewarm->workers) {
+		worker.join();
+	}
+	auto now = PrewarmJob::clock::now();
+
+	for (auto& task : prewarm->tasks) {
+		const char* ext = core->TypeExt(task.type);
+		if (!task.table && !task.symbol) {
+			Log(DEBUG, "GameData", "Prewarm: {}.{} not found", task.name, ext);
+			continue;
+		}
+		Log(DEBUG, "GameData", "Prewarm: {}.{} parsed in {}us", task.name, ext,
+			duration_cast<microseconds>(task.time).count());
+		if (task.table) {
+			// the main thread may have needed it in the meantime
+			tables.emplace(task.name, std::move(task.table));
+		} else {
+			prewarmedSymbols.emplace(task.name, std::move(task.symbol));
+		}
+	}
+	Log(MESSAGE, "GameData", "Prewarmed {} resources on {} threads in {}ms, waited {}ms for them.",
+		prewarm->tasks.size(), prewarm->workers.size(),
+		duration_cast<milliseconds>(now - prewarm->start).count(),
+		duration_cast<milliseconds>(now - waitStart).count());
+	prewarm.reset();
+}
+
+PluginHolder<SymbolMgr> GameData::TakePrewarmedSymbol(const ResRef& symbolRef)
+{
+	auto it = prewarmedSymbols.find(symbolRef);
+	if (it == prewarmedSymbols.end()) {
+		return nullptr;
+	}
+	PluginHolder<SymbolMgr> sm = std::move(it->second);
+	prewarmedSymbols.erase(it);
+	return sm;
+}
+
+void GameData::SetRetentionBudget(size_t bytes)
+{
+	ItemCache.SetRetention(bytes, ReleaseItem);
+	SpellCache.SetRetention(bytes, ReleaseSpell);
+	EffectCache.SetRetention(bytes, ReleaseEffect);
+}
+
 void GameData::ClearCaches()
 {
+	LogCacheStats("Item", ItemCache);
+	LogCacheStats("Spell", SpellCache);
+	LogCacheStats("Effect", EffectCache);
+
+	FinishPrewarm();
+	prewarmedSymbols.clear();
 	ItemCache.RemoveAll(ReleaseItem);
 	SpellCache.RemoveAll(ReleaseSpell);
 	EffectCache.RemoveAll(ReleaseEffect);
@@ -150,16 +314,8 @@ AutoTable GameData::LoadTable(const ResRef& tableRef, bool silent)
 		return tables.at(tableRef);
 	}
 
-	DataStream* str = GetResource(tableRef, IE_2DA_CLASS_ID, silent);
-	if (!str) {
-		return nullptr;
-	}
-	PluginHolder<TableMgr> tm = MakePluginHolder<TableMgr>(IE_2DA_CLASS_ID);
+	PluginHolder<TableMgr> tm = ParseResource<TableMgr>(*this, tableRef, IE_2DA_CLASS_ID, silent);
 	if (!tm) {
-		delete str;
-		return nullptr;
-	}
-	if (!tm->Open(str)) {
 		return nullptr;
 	}
 
@@ -215,12 +371,14 @@ void GameData::FreeItem(Item const *itm, const ResRef &name, bool free)
 {
 	int res;
 
-	res = ItemCache.DecRef((const void *) itm, name, free);
+	if (free) {
+		res = ItemCache.Release((const void *) itm, name, ItemSize(itm));
+	} else {
+		res = ItemCache.DecRef((const void *) itm, name, false);
+	}
 	if (res<0) {
 		error("Core", "Corrupted Item cache encountered (reference count went below zero), Item name is: {}", name);
 	}
-	if (res) return;
-	if (free) delete itm;
 }
 
 Spell* GameData::GetSpell(const ResRef &resname, bool silent)
@@ -253,13 +411,16 @@ Spell* GameData::GetSpell(const ResRef &resname, bool silent)
 
 void GameData::FreeSpell(const Spell *spl, const ResRef &name, bool free)
 {
-	int res = SpellCache.DecRef((const void *) spl, name, free);
+	int res;
+	if (free) {
+		res = SpellCache.Release((const void *) spl, name, SpellSize(spl));
+	} else {
+		res = SpellCache.DecRef((const void *) spl, name, false);
+	}
 	if (res<0) {
 		error("Core", "Corrupted Spell cache encountered (reference count went below zero), Spell name is: {} or {}",
 			name, spl->Name);
 	}
-	if (res) return;
-	if (free) delete spl;
 }
 
 Effect* GameData::GetEffect(const ResRef &resname)
@@ -289,12 +450,15 @@ Effect* GameData::GetEffect(const ResRef &resname)
 
 void GameData::FreeEffect(const Effect *eff, const ResRef &name, bool free)
 {
-	int res = EffectCache.DecRef((const void *) eff, name, free);
+	int res;
+	if (free) {
+		res = EffectCache.Release((const void *) eff, name, sizeof(Effect));
+	} else {
+		res = EffectCache.DecRef((const void *) eff, name, false);
+	}
 	if (res<0) {
 		error("Core", "Corrupted Effect cache encountered (reference count went below zero), Effect name is: {}", name);
 	}
-	if (res) return;
-	if (free) delete eff;
 }
 
 //if the default setup doesn't fit for an animation
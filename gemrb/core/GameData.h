@@ -30,6 +30,7 @@
 #include "Holder.h"
 #include "Palette.h"
 #include "Resource.h"
+#include "PluginMgr.h"
 #include "ResourceManager.h"
 #include "SrcMgr.h"
 #include "TableMgr.h"
@@ -51,6 +52,7 @@ class ScriptedAnimation;
 class Spell;
 class Sprite2D;
 class Store;
+class SymbolMgr;
 class VEFObject;
 
 struct IWDIDSEntry {
@@ -97,6 +99,9 @@ public:
 
 	using index_t = uint16_t;
 	void ClearCaches();
+	/** unreferenced items, spells and effects freed by their users are kept
+	 * around until each cache holds more than this many bytes of them */
+	void SetRetentionBudget(size_t bytes);
 
 	/** Returns actor */
 	Actor* GetCreature(const ResRef& creature, unsigned int PartySlot = 0);
@@ -104,6 +109,15 @@ public:
 	int LoadCreature(const ResRef& creature, unsigned int PartySlot, bool character = false, int VersionOverride = -1);
 
 
+	/** Starts parsing the given tables and symbol files on worker threads,
+	 * while the main thread goes on with its own (video) setup */
+	void StartPrewarm(const std::vector<ResRef>& tableRefs, const std::vector<ResRef>& symbolRefs);
+	/** Waits for the workers and makes their results available to
+	 * LoadTable and TakePrewarmedSymbol */
+	void FinishPrewarm();
+	/** Hands over a symbol file parsed by the prewarm, if there is one */
+	PluginHolder<SymbolMgr> TakePrewarmedSymbol(const ResRef& symbolRef);
+
 	// 2DA table functions.
 	// (See also the AutoTable class)
 
@@ -188,6 +202,9 @@ private:
 	ResRefMap<PaletteHolder> PaletteCache;
 	Factory* factory;
 	ResRefMap<AutoTable> tables;
+	ResRefMap<PluginHolder<SymbolMgr>> prewarmedSymbols;
+	struct PrewarmJob;
+	std::unique_ptr<PrewarmJob> prewarm;
 	using StoreMap = std::map<ResRef, Store*>;
 	StoreMap stores;
 	std::map<size_t, std::vector<ResRef>> ItemSounds;
@@ -49,6 +49,7 @@
 #include "GameData.h"
 #include "Interface.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "TableMgr.h"
 #include "RNG.h"
 
@@ -1241,33 +1242,56 @@ static const IDSLink* FindIdentifier(const char* idsname)
 
 /********************** Targets **********************************/
 
+static bool NearerTarget(const targettype& a, const targettype& b)
+{
+	return a.distance < b.distance || (a.distance == b.distance && a.order < b.order);
+}
+
 int Targets::Count() const
 {
 	return (int)objects.size();
 }
 
-targettype *Targets::RemoveTargetAt(targetlist::iterator &m)
+void Targets::Sort()
 {
-	m=objects.erase(m);
-	if (m!=objects.end() ) {
-		return &(*m);
+	if (!sorted) {
+		std::sort(objects.begin(), objects.end(), NearerTarget);
+		sorted = true;
 	}
-	return NULL;
+}
+
+// partial selection of the index-th nearest target, for when nobody needs the whole order
+const targettype *Targets::Select(unsigned int index, int Type)
+{
+	auto first = objects.begin();
+	auto last = objects.end();
+	if (Type != -1) {
+		last = std::partition(first, last, [Type](const targettype& t) {
+			return t.actor->Type == Type;
+		});
+	}
+	if (index >= unsigned(last - first)) {
+		return nullptr;
+	}
+	std::nth_element(first, first + index, last, NearerTarget);
+	return &*(first + index);
 }
 
 const targettype *Targets::GetLastTarget(int Type)
 {
-	targetlist::const_iterator m = objects.end();
-	while (m--!=objects.begin() ) {
-		if (Type == -1 || (*m).actor->Type == Type) {
-			return &(*m);
+	const targettype *last = nullptr;
+	for (const auto& object : objects) {
+		if (Type != -1 && object.actor->Type != Type) continue;
+		if (!last || NearerTarget(*last, object)) {
+			last = &object;
 		}
 	}
-	return nullptr;
+	return last;
 }
 
 const targettype *Targets::GetFirstTarget(targetlist::iterator &m, int Type)
 {
+	Sort();
 	m=objects.begin();
 	while (m!=objects.end() ) {
 		if (Type != -1 && (*m).actor->Type != Type) {
@@ -1294,15 +1318,18 @@ const targettype *Targets::GetNextTarget(targetlist::iterator &m, int Type)
 
 Scriptable *Targets::GetTarget(unsigned int index, int Type)
 {
-	targetlist::iterator m = objects.begin();
-	while(m!=objects.end() ) {
-		if (Type == -1 || (*m).actor->Type == Type) {
+	if (!sorted) {
+		const targettype *t = Select(index, Type);
+		return t ? t->actor : nullptr;
+	}
+
+	for (const auto& object : objects) {
+		if (Type == -1 || object.actor->Type == Type) {
 			if (!index) {
-				return (*m).actor;
+				return object.actor;
 			}
 			index--;
 		}
-		++m;
 	}
 	return NULL;
 }
@@ -1328,19 +1355,18 @@ void Targets::AddTarget(Scriptable* target, unsigned int distance, int ga_flags)
 	default:
 		break;
 	}
-	targettype Target = {target, distance};
-	for (auto m = objects.begin(); m != objects.end(); ++m) {
-		if ( (*m).distance>distance) {
-			objects.insert( m, Target);
-			return;
-		}
+	// no sorted insert, most lists are only asked for one or two targets
+	if (!objects.empty() && objects.back().distance > distance) {
+		sorted = false;
 	}
-	objects.push_back( Target );
+	objects.push_back({ target, distance, added++ });
 }
 
 void Targets::Clear()
 {
 	objects.clear();
+	sorted = true;
+	added = 0;
 }
 
 void Targets::dump() const
@@ -1358,13 +1384,9 @@ void Targets::FilterObjectRect(const Object *oC)
 	// can't match anything if the second pair of coordinates (or all of them) are unset
 	if (oC->objectRect.w <= 0 || oC->objectRect.h <= 0) return;
 
-	for (auto m = objects.begin(); m != objects.end();) {
-		if (!IsInObjectRect((*m).actor->Pos, oC->objectRect)) {
-			m = objects.erase(m);
-		} else {
-			++m;
-		}
-	}
+	Filter(-1, [oC](const targettype& t) {
+		return IsInObjectRect(t.actor->Pos, oC->objectRect);
+	});
 }
 
 /** releasing global memory */
@@ -2010,6 +2032,7 @@ static Condition* ReadCondition(DataStream* stream)
  */
 bool GameScript::Update(bool *continuing, bool *done)
 {
+	PROFILE_SCOPE(GameScript);
 	if (!MySelf)
 		return false;
 
@@ -2292,6 +2315,55 @@ bool Condition::Evaluate(Scriptable *Sender) const
 	return true;
 }
 
+// pure variable checks without side effects on the sender
+static const TriggerFunction cheapTriggerFunctions[] = {
+	GameScript::True, GameScript::False, GameScript::BitCheck, GameScript::BitCheckExact,
+	GameScript::Global, GameScript::GlobalLT, GameScript::GlobalGT,
+	GameScript::G_Trigger, GameScript::GLT_Trigger, GameScript::GGT_Trigger,
+	GameScript::GlobalLTGlobal, GameScript::GlobalGTGlobal,
+	GameScript::GlobalsEqual, GameScript::GlobalsGT, GameScript::GlobalsLT,
+	GameScript::LocalsEqual, GameScript::LocalsGT, GameScript::LocalsLT,
+	GameScript::GlobalTimerExact, GameScript::GlobalTimerExpired,
+	GameScript::GlobalTimerNotExpired, GameScript::GlobalTimerStarted
+};
+
+static bool IsCheapTrigger(unsigned short triggerID)
+{
+	if (triggerID >= MAX_TRIGGERS || !triggers[triggerID]) {
+		return false;
+	}
+	for (TriggerFunction func : cheapTriggerFunctions) {
+		if (triggers[triggerID] == func) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void Condition::PreparePrefilter()
+{
+	cheapTriggers.clear();
+	// only the leading run of cheap checks is taken: Evaluate stops at the first
+	// false trigger as well, so skipping it can't drop the side effects (LastTrigger,
+	// LastMarked) of any trigger that would have run before that one
+	for (size_t i = 0; i < triggers.size(); ++i) {
+		if (!IsCheapTrigger(triggers[i]->triggerID)) {
+			break;
+		}
+		cheapTriggers.push_back(i);
+	}
+}
+
+bool Condition::Prefilter(Scriptable *Sender) const
+{
+	for (size_t i : cheapTriggers) {
+		if (i < triggers.size() && !triggers[i]->Evaluate(Sender)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /* this may return more than a boolean, in case of Or(x) */
 int Trigger::Evaluate(Scriptable *Sender) const
 {
@@ -23,12 +23,14 @@
 
 #include "exports.h"
 
+#include "FrameArena.h"
 #include "Interface.h"
 #include "SymbolMgr.h"
 #include "Variables.h"
 #include "Scriptable/Actor.h"
 #include "Streams/DataStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 
@@ -144,18 +146,25 @@ static_assert(std::is_standard_layout<StringParam>::value, "Fixed Size String mu
 struct targettype {
 	Scriptable *actor; //hmm, could be door
 	unsigned int distance;
+	unsigned int order; // insertion order, breaks distance ties
 };
 
-using targetlist = std::list<targettype>;
+// target lists only live while an object is evaluated, so they come from the frame arena
+using targetlist = FrameVector<targettype>;
 
 class GEM_EXPORT Targets {
+	// kept in insertion order until something needs them sorted by distance
 	targetlist objects;
+	bool sorted = true;
+	unsigned int added = 0;
+
+	void Sort();
+	const targettype *Select(unsigned int index, int Type);
 public:
 	Targets() noexcept {};
 	
 	int Count() const;
 	void dump() const;
-	targettype *RemoveTargetAt(targetlist::iterator &m);
 	const targettype *GetNextTarget(targetlist::iterator &m, int Type);
 	const targettype *GetLastTarget(int Type);
 	const targettype *GetFirstTarget(targetlist::iterator &m, int Type);
@@ -163,6 +172,16 @@ public:
 	void AddTarget(Scriptable* target, unsigned int distance, int flags);
 	void Clear();
 	void FilterObjectRect(const Object *oC);
+
+	// removes the targets of Type (-1 for any) that keep() rejects, the rest stay in order
+	template <typename PRED>
+	void Filter(int Type, PRED keep)
+	{
+		auto last = std::remove_if(objects.begin(), objects.end(), [&](const targettype& t) {
+			return (Type == -1 || t.actor->Type == Type) && !keep(t);
+		});
+		objects.erase(last, objects.end());
+	}
 };
 
 class Canary {
@@ -271,8 +290,14 @@ public:
 		delete this;
 	}
 	bool Evaluate(Scriptable *Sender) const;
+	// collects the leading cheap variable checks for Prefilter, call after filling triggers
+	void PreparePrefilter();
+	// false if one of the cheap checks fails, which means Evaluate would fail too
+	bool Prefilter(Scriptable *Sender) const;
 
 	std::vector<Trigger*> triggers;
+private:
+	std::vector<size_t> cheapTriggers;
 };
 
 class GEM_EXPORT Action final : protected Canary {
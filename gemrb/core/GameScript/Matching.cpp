@@ -62,15 +62,10 @@ static inline bool DoObjectIDSCheck(const Object *oC, const Actor *ac, bool *fil
 
 /* do object filtering: Myself, LastAttackerOf(Player1), etc */
 static inline Targets *DoObjectFiltering(const Scriptable *Sender, Targets *tgts, const Object *oC, int ga_flags) {
-	targetlist::iterator m;
-	const targettype *tt = tgts->GetFirstTarget(m, ST_ACTOR);
-	while (tt) {
-		const Actor *target = static_cast<const Actor*>(tt->actor);
-		if (oC->objectName[0] || target->ValidTarget(GA_NO_DEAD)) {
-			tt = tgts->GetNextTarget(m, ST_ACTOR);
-		} else {
-			tt = tgts->RemoveTargetAt(m);
-		}
+	if (!oC->objectName[0]) {
+		tgts->Filter(ST_ACTOR, [](const targettype& t) {
+			return static_cast<const Actor*>(t.actor)->ValidTarget(GA_NO_DEAD);
+		});
 	}
 
 	for (int i = 0; i < MaxObjectNesting; i++) {
@@ -551,27 +546,16 @@ Targets *XthNearestMyGroupOfType(const Scriptable *origin, Targets *parameters,
 		return parameters;
 	}
 
-	targetlist::iterator m;
-	const targettype *t = parameters->GetFirstTarget(m, ST_ACTOR);
-	if (!t) {
+	if (!parameters->GetTarget(0, ST_ACTOR)) {
 		return parameters;
 	}
 	const Actor *actor = static_cast<const Actor*>(origin);
 	//determining the specifics of origin
 	ieDword type = actor->GetStat(IE_SPECIFIC); //my group
 
-	while ( t ) {
-		if (t->actor->Type!=ST_ACTOR) {
-			t=parameters->RemoveTargetAt(m);
-			continue;
-		}
-		actor = static_cast<const Actor*>(t->actor);
-		if (actor->GetStat(IE_SPECIFIC) != type) {
-			t=parameters->RemoveTargetAt(m);
-			continue;
-		}
-		t = parameters->GetNextTarget(m, ST_ACTOR);
-	}
+	parameters->Filter(ST_ACTOR, [type](const targettype& t) {
+		return static_cast<const Actor*>(t.actor)->GetStat(IE_SPECIFIC) == type;
+	});
 	return XthNearestOf(parameters,count, ga_flags);
 }
 
@@ -634,9 +618,7 @@ Targets *XthNearestEnemyOfType(const Scriptable *origin, Targets *parameters, un
 		return parameters;
 	}
 
-	targetlist::iterator m;
-	const targettype *t = parameters->GetFirstTarget(m, ST_ACTOR);
-	if (!t) {
+	if (!parameters->GetTarget(0, ST_ACTOR)) {
 		return parameters;
 	}
 	const Actor *actor = static_cast<const Actor*>(origin);
@@ -649,30 +631,17 @@ Targets *XthNearestEnemyOfType(const Scriptable *origin, Targets *parameters, un
 	}
 
 	ieDword gametime = core->GetGame()->GameTime;
-	while ( t ) {
-		if (t->actor->Type!=ST_ACTOR) {
-			t=parameters->RemoveTargetAt(m);
-			continue;
-		}
-		actor = static_cast<const Actor*>(t->actor);
+	parameters->Filter(ST_ACTOR, [type, gametime](const targettype& t) {
+		const Actor *target = static_cast<const Actor*>(t.actor);
 		// IDS targeting already did object checks (unless we need to override Detect?)
-		if (!actor->Schedule(gametime, true)) {
-			t = parameters->RemoveTargetAt(m);
-			continue;
+		if (!target->Schedule(gametime, true)) {
+			return false;
 		}
 		if (type) { //origin is PC
-			if (actor->GetStat(IE_EA) <= EA_EVILCUTOFF) {
-				t=parameters->RemoveTargetAt(m);
-				continue;
-			}
-		} else {
-			if (actor->GetStat(IE_EA) >= EA_GOODCUTOFF) {
-				t=parameters->RemoveTargetAt(m);
-				continue;
-			}
+			return target->GetStat(IE_EA) > EA_EVILCUTOFF;
 		}
-		t = parameters->GetNextTarget(m, ST_ACTOR);
-	}
+		return target->GetStat(IE_EA) < EA_GOODCUTOFF;
+	});
 	return XthNearestOf(parameters,count, ga_flags);
 }
 
@@ -0,0 +1,57 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "GameScript/ScriptScheduler.h"
+
+#include "Interface.h"
+#include "Logging/Logging.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+void ScriptScheduler::NewTick()
+{
+	lastSpent = spent;
+	lastDeferred = deferred;
+	if (deferred > peakDeferred) {
+		peakDeferred = deferred;
+#ifndef NDEBUG
+		Log(DEBUG, "ScriptScheduler", "New peak of deferred script rounds: {} ({} ran)", deferred, spent);
+#endif
+	}
+
+	spent = 0;
+	deferred = 0;
+	budget = unsigned(std::max(0, core->config.ScriptBudget));
+}
+
+bool ScriptScheduler::Admit(Priority priority)
+{
+	if (budget && spent >= budget && priority == Priority::Routine) {
+		deferred++;
+		return false;
+	}
+	// urgent rounds still use up the budget, so the routine ones make way for them
+	spent++;
+	return true;
+}
+
+}
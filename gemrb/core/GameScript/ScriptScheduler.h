@@ -0,0 +1,76 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+/**
+ * @file ScriptScheduler.h
+ * Declares ScriptScheduler, which spreads the script rounds of an area over its ticks.
+ * @author The GemRB Project
+ */
+
+#ifndef SCRIPTSCHEDULER_H
+#define SCRIPTSCHEDULER_H
+
+#include "exports.h"
+#include "ie_types.h"
+
+namespace GemRB {
+
+/**
+ * @class ScriptScheduler
+ * Every scriptable asks its area for permission before evaluating a due
+ * script round. Routine rounds are only granted while the budget of the
+ * current tick lasts, the rest are deferred to the next tick. Rounds with
+ * pending triggers and rounds that were already deferred for a whole round
+ * always run, so reactions are never late and nobody starves.
+ */
+
+class GEM_EXPORT ScriptScheduler {
+public:
+	// ticks between two script rounds of the same scriptable
+	static constexpr ieDword RoundTicks = 16;
+
+	enum class Priority {
+		Routine,
+		Triggered, // attacked, heard, seen or otherwise woken up
+		Overdue // deferred for a whole round already
+	};
+
+	// called once per area tick, before any of its scriptables run
+	void NewTick();
+	// false means the round has to wait for the next tick
+	bool Admit(Priority priority);
+
+	// rounds put off in the last full tick
+	unsigned int Deferred() const { return lastDeferred; }
+	// rounds evaluated in the last full tick
+	unsigned int Evaluated() const { return lastSpent; }
+
+private:
+	unsigned int budget = 0; // 0 means unlimited
+	unsigned int spent = 0;
+	unsigned int deferred = 0;
+	unsigned int lastSpent = 0;
+	unsigned int lastDeferred = 0;
+	unsigned int peakDeferred = 0;
+};
+
+}
+
+#endif
@@ -28,9 +28,27 @@
 
 namespace GemRB {
 
+tick_t GlobalTimer::Now()
+{
+	if (!fixedStep) {
+		return GetMilliseconds();
+	}
+
+	// pretend exactly one tick passed since the last call, so the
+	// simulation runs as fast as the cpu allows and stays reproducible
+	virtualTime += core->Time.Ticks2Ms(1);
+	return virtualTime;
+}
+
+void GlobalTimer::SetFixedStep(bool fixed)
+{
+	fixedStep = fixed;
+	virtualTime = startTime;
+}
+
 void GlobalTimer::Freeze()
 {
-	tick_t thisTime = GetMilliseconds();
+	tick_t thisTime = Now();
 
 	if (UpdateViewport(thisTime) == false) {
 		return;
@@ -132,7 +150,7 @@ bool GlobalTimer::Update()
 	Map *map;
 	Game *game;
 	const GameControl* gc;
-	tick_t thisTime = GetMilliseconds();
+	tick_t thisTime = Now();
 
 	if (!startTime) {
 		goto end;
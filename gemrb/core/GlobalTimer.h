@@ -30,6 +30,9 @@ namespace GemRB {
 class GEM_EXPORT GlobalTimer {
 private:
 	tick_t startTime = 0; //forcing an update;
+	// headless simulation: advance a virtual clock by one tick per update
+	bool fixedStep = false;
+	tick_t virtualTime = 0;
 
 	tick_t fadeToCounter = 0;
 	tick_t fadeToMax = 0;
@@ -46,6 +49,7 @@ private:
 
 	void DoFadeStep(ieDword count);
 	bool UpdateViewport(tick_t time);
+	tick_t Now();
 public:
 	GlobalTimer() noexcept = default;
 	
@@ -54,6 +58,8 @@ public:
 
 	void Freeze();
 	bool Update();
+	/** Decouples game time from the wall clock, so every update runs exactly one tick */
+	void SetFixedStep(bool fixed);
 	bool ViewportIsMoving() const;
 	void DoStep(int count);
 	void SetMoveViewPort(Point p, int spd, bool center);
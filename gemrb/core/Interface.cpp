@@ -38,6 +38,7 @@
 #include "EffectQueue.h"
 #include "Factory.h"
 #include "FontManager.h"
+#include "FrameArena.h"
 #include "Game.h"
 #include "GameScript/GameScript.h"
 #include "ItemMgr.h"
@@ -51,6 +52,7 @@
 #endif
 #include "PluginMgr.h"
 #include "Predicates.h"
+#include "Profiler.h"
 #include "ProjectileServer.h"
 #include "SaveGameIterator.h"
 #include "SaveGameMgr.h"
@@ -75,7 +77,11 @@
 #include "GUI/WorldMapControl.h"
 #include "RNG.h"
 #include "Scriptable/Container.h"
+#include "Streams/BufferStream.h"
 #include "Streams/FileStream.h"
+#if defined(SUPPORTS_MEMSTREAM)
+#include "Streams/MappedFileMemoryStream.h"
+#endif
 #include "System/FileFilters.h"
 
 #include <utility>
@@ -195,6 +201,20 @@ static const ieWord IDT_SKILLPENALTY = 3;
 
 static int MagicBit = 0;
 static const char* DefaultSystemEncoding = "UTF-8";
+// snapshot of the resource lookups, kept in the cache between runs
+static const char* const ResourceIndexFile = "resources.idx";
+// parsed on worker threads during startup, missing ones are skipped
+static const std::vector<ResRef> PrewarmTables = {
+	"avatars", "avprefix", "backstab", "classes", "clskills", "colors", "crits", "damage",
+	"death", "difflvls", "dmgtypes", "efftext", "gametime", "itemanim", "itemdata", "itemsnd",
+	"itemtype", "itemuse", "kitlist", "modal", "monkbon", "moverate", "numwslot", "overlay",
+	"qslots", "races", "randitem", "reputati", "shadows", "skilldex", "skillrac", "slottype",
+	"sndchann", "splprot", "splspec", "stances", "summlimt", "traplimt", "wildmag", "wspatck",
+	"wspecial", "xpbonus", "xpcap", "xplevel"
+};
+static const std::vector<ResRef> PrewarmSymbols = {
+	"action", "gemact", "gemtrig", "object", "race", "stats", "svtriobj", "trigger"
+};
 
 // FIXME: DragOp should be initialized with the button we are dragging from
 // for now use a dummy until we truly implement this as a drag event
@@ -301,6 +321,9 @@ Interface::~Interface() noexcept
 
 	Actor::ReleaseMemory();
 
+	char indexPath[_MAX_PATH];
+	PathJoin(indexPath, config.CachePath, ResourceIndexFile, nullptr);
+	gamedata->SaveIndex(indexPath);
 	gamedata->ClearCaches();
 	delete gamedata;
 	gamedata = NULL;
@@ -613,11 +636,17 @@ void Interface::Main()
 	fpsRgn.y = 0;
 
 	tick_t frame = 0;
+	tick_t tick = 0;
+	// the headless simulation runs as fast as it can
+	unsigned int fpscap = config.Headless ? 0 : 30;
 	tick_t time = GetMilliseconds();
 	tick_t timebase = time;
 	double frames = 0.0;
 
 	do {
+		Profiler::NextFrame();
+		// nothing from the previous frame may still be using the arena here
+		FrameArena::Get().Reset();
 		for (auto it = timers.begin(); it != timers.end();) {
 			if (it->IsRunning()) {
 				it->Update(time);
@@ -644,8 +673,15 @@ void Interface::Main()
 		// TODO: find other animations that need to be synchronized
 		// we can create a manager for them and everything can be updated at once
 		GlobalColorCycle.AdvanceTime(time);
-		winmgr->DrawWindows();
 		time = GetMilliseconds();
+		if (config.Headless) {
+			// each loop is exactly one tick, so just skip drawing most of them
+			tick++;
+			if (!config.HeadlessDrawInterval || tick % config.HeadlessDrawInterval) {
+				continue;
+			}
+		}
+		winmgr->DrawWindows();
 		if (config.DrawFPS) {
 			frame++;
 			if (time - timebase > 1000) {
@@ -658,7 +694,11 @@ void Interface::Main()
 			video->DrawRect( fpsRgn, ColorBlack );
 			fps->Print(fpsRgn, String(fpsstring), IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE, {ColorWhite, ColorBlack});
 		}
-	} while (video->SwapBuffers() == GEM_OK && !(QuitFlag&QF_KILL));
+		if (Profiler::IsEnabled()) {
+			auto lock = winmgr->DrawHUD();
+			Profiler::Draw(Region(5, 35, 0, 0));
+		}
+	} while (video->SwapBuffers(fpscap) == GEM_OK && !(QuitFlag&QF_KILL));
 	QuitGame(0);
 }
 
@@ -799,11 +839,14 @@ int Interface::Init(const InterfaceConfig* cfg)
 		value = nullptr
 
 	CONFIG_INT("Bpp", config.Bpp =);
+	CONFIG_INT("CacheCompressedBIFs", config.CacheCompressedBIFs =);
 	CONFIG_INT("CaseSensitive", config.CaseSensitive =);
 	CONFIG_INT("DoubleClickDelay", EventMgr::DCDelay = );
 	CONFIG_INT("DrawFPS", config.DrawFPS =);
 	CONFIG_INT("EnableCheatKeys", EnableCheatKeys);
 	CONFIG_INT("GCDebug", GameControl::DebugFlags = );
+	CONFIG_INT("Headless", config.Headless =);
+	CONFIG_INT("HeadlessDrawInterval", config.HeadlessDrawInterval =);
 	CONFIG_INT("Height", config.Height =);
 	CONFIG_INT("KeepCache", config.KeepCache =);
 	CONFIG_INT("MaxPartySize", config.MaxPartySize =);
@@ -811,8 +854,14 @@ int Interface::Init(const InterfaceConfig* cfg)
 	vars->SetAt("MaxPartySize", config.MaxPartySize); // for simple GUIScript access
 	CONFIG_INT("MouseFeedback", config.MouseFeedback =);
 	CONFIG_INT("MultipleQuickSaves", config.MultipleQuickSaves =);
+	int profile = 0;
+	CONFIG_INT("Profile", profile =);
+	Profiler::Enable(profile);
 	CONFIG_INT("RepeatKeyDelay", Control::ActionRepeatDelay =);
+	CONFIG_INT("ResidentCacheSize", config.ResidentCacheSize =);
+	gamedata->SetRetentionBudget(std::max(0, config.ResidentCacheSize) * size_t(1024));
 	CONFIG_INT("SaveAsOriginal", config.SaveAsOriginal =);
+	CONFIG_INT("ScriptBudget", config.ScriptBudget =);
 	CONFIG_INT("DebugMode", config.debugMode =);
 	int touchInput = -1;
 	CONFIG_INT("TouchInput", touchInput =);
@@ -961,6 +1010,20 @@ int Interface::Init(const InterfaceConfig* cfg)
 	CONFIG_STRING("Encoding", config.Encoding);
 #undef CONFIG_STRING
 
+	if (config.Headless) {
+		// no window or sound, unless explicitly asked for
+		if (!cfg->GetValueForKey("VideoDriver")) config.VideoDriverName = "none";
+		if (!cfg->GetValueForKey("AudioDriver")) config.AudioDriverName = "none";
+		timer.SetFixedStep(true);
+		Log(MESSAGE, "Core", "Running headless, drawing every {} ticks.", config.HeadlessDrawInterval);
+	}
+
+	// only the main thread is seeded, but that is where all the game logic runs
+	value = cfg->GetValueForKey("RandomSeed");
+	if (value) {
+		RNG::getInstance().Seed(strtounsigned<uint32_t>(value->c_str()));
+	}
+
 	value = cfg->GetValueForKey("ModPath");
 	if (value) {
 		config.ModPath = Explode<std::string, std::string>(*value, PathListSeparator);
@@ -1064,7 +1127,7 @@ int Interface::Init(const InterfaceConfig* cfg)
 
 	char path[_MAX_PATH];
 	PathJoin(path, config.CachePath, nullptr);
-	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY)) {
+	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY, RM_VOLATILE_SOURCE)) {
 		Log(FATAL, "Core", "The cache path couldn't be registered, please check!");
 		return GEM_ERROR;
 	}
@@ -1161,6 +1224,9 @@ int Interface::Init(const InterfaceConfig* cfg)
 	// Purposely add the font directory last since we will only ever need it at engine load time.
 	if (config.CustomFontPath[0]) gamedata->AddSource(config.CustomFontPath, "CustomFonts", PLUGIN_RESOURCE_DIRECTORY);
 
+	PathJoin(path, config.CachePath, ResourceIndexFile, nullptr);
+	gamedata->LoadIndex(path);
+
 	Log(MESSAGE, "Core", "Reading Game Options...");
 	if (!LoadGemRBINI()) {
 		Log(FATAL, "Core", "Cannot Load INI.");
@@ -1237,11 +1303,23 @@ int Interface::Init(const InterfaceConfig* cfg)
 		Log(FATAL, "Core", "No TLK Importer Available.");
 		return GEM_ERROR;
 	}
+	// the tlk importer reads the entries straight from the mapping when it can
+	auto OpenTLK = [](const char* tlkPath) -> DataStream* {
+#if defined(SUPPORTS_MEMSTREAM)
+		auto mapped = new MappedFileMemoryStream{tlkPath};
+		if (mapped->isOk()) {
+			return mapped;
+		}
+		delete mapped;
+#endif
+		return FileStream::OpenFile(tlkPath);
+	};
+
 	strings = MakePluginHolder<StringMgr>(IE_TLK_CLASS_ID);
 	Log(MESSAGE, "Core", "Loading Dialog.tlk file...");
 	char strpath[_MAX_PATH];
 	PathJoin(strpath, config.GamePath, "dialog.tlk", nullptr);
-	FileStream* fs = FileStream::OpenFile(strpath);
+	DataStream* fs = OpenTLK(strpath);
 	if (!fs) {
 		Log(FATAL, "Core", "Cannot find Dialog.tlk.");
 		return GEM_ERROR;
@@ -1253,7 +1331,7 @@ int Interface::Init(const InterfaceConfig* cfg)
 		strings2 = MakePluginHolder<StringMgr>(IE_TLK_CLASS_ID);
 		Log(MESSAGE, "Core", "Loading DialogF.tlk file...");
 		PathJoin(strpath, config.GamePath, "dialogf.tlk", nullptr);
-		fs = FileStream::OpenFile(strpath);
+		fs = OpenTLK(strpath);
 		if (!fs) {
 			Log(ERROR, "Core", "Cannot find DialogF.tlk. Let us know which translation you are using.");
 			Log(ERROR, "Core", "Falling back to main TLK file, so female text may be wrong!");
@@ -1263,6 +1341,10 @@ int Interface::Init(const InterfaceConfig* cfg)
 		}
 	}
 
+	// the video objects below are set up on the main thread in the meantime
+	Log(MESSAGE, "Core", "Prewarming game data tables...");
+	gamedata->StartPrewarm(PrewarmTables, PrewarmSymbols);
+
 	Log(MESSAGE, "Core", "Loading palettes...");
 	LoadPalette<16>(Palette16, palettes16);
 	LoadPalette<32>(Palette32, palettes32);
@@ -1394,6 +1476,8 @@ int Interface::Init(const InterfaceConfig* cfg)
 	calendar = NULL;
 	keymap = NULL;
 
+	gamedata->FinishPrewarm();
+
 	Log(MESSAGE, "Core", "Initializing Inventory Management...");
 	ret = InitItemTypes();
 	if (!ret) {
@@ -1586,6 +1670,26 @@ String Interface::GetString(ieStrRef strref, STRING_FLAGS options) const
 	}
 }
 
+void Interface::PrefetchStrings(const std::vector<ieStrRef>& strrefs) const
+{
+	if (!strings2) {
+		strings->Prefetch(strrefs);
+		return;
+	}
+
+	std::vector<ieStrRef> main;
+	std::vector<ieStrRef> alt;
+	for (ieStrRef strref : strrefs) {
+		if (strref != ieStrRef::INVALID && bool(strref & ieStrRef::ALTREF)) {
+			alt.push_back(strref);
+		} else {
+			main.push_back(strref);
+		}
+	}
+	strings->Prefetch(main);
+	strings2->Prefetch(alt);
+}
+
 std::string Interface::GetMBString(ieStrRef strref, STRING_FLAGS options) const
 {
 	String string = GetString(strref, options);
@@ -2105,6 +2209,11 @@ void Interface::GameLoop(void)
 			// the game object will run the area scripts as well
 			game->UpdateScripts();
 		}
+		// once per loop like the drawing used to, but also when nothing is drawn
+		Map* area = game->GetCurrentArea();
+		if (area) {
+			area->UpdateVisualEffects();
+		}
 	}
 }
 
@@ -2223,17 +2332,20 @@ int Interface::LoadSymbol(const ResRef& ref)
 	if (ind != -1) {
 		return ind;
 	}
-	DataStream* str = gamedata->GetResource(ref, IE_IDS_CLASS_ID);
-	if (!str) {
-		return -1;
-	}
-	PluginHolder<SymbolMgr> sm = MakePluginHolder<SymbolMgr>(IE_IDS_CLASS_ID);
+	PluginHolder<SymbolMgr> sm = gamedata->TakePrewarmedSymbol(ref);
 	if (!sm) {
-		delete str;
-		return -1;
-	}
-	if (!sm->Open(str)) {
-		return -1;
+		DataStream* str = gamedata->GetResource(ref, IE_IDS_CLASS_ID);
+		if (!str) {
+			return -1;
+		}
+		sm = MakePluginHolder<SymbolMgr>(IE_IDS_CLASS_ID);
+		if (!sm) {
+			delete str;
+			return -1;
+		}
+		if (!sm->Open(str)) {
+			return -1;
+		}
 	}
 	Symbol s = { sm, ref };
 	ind = -1;
@@ -3245,6 +3357,7 @@ void Interface::RemoveFromCache(const ResRef& resref, SClass_ID ClassID) const
 
 	PathJoinExt(filename, config.CachePath, resref.c_str(), TypeExt(ClassID));
 	unlink ( filename);
+	ResourceManager::FileChanged(filename);
 }
 
 //this function checks if the path is eligible as a cache
@@ -3307,6 +3420,7 @@ void Interface::DelTree(const char* Pt, bool onlysave) const
 			char dtmp[_MAX_PATH];
 			dir.GetFullPath(dtmp);
 			unlink( dtmp );
+			ResourceManager::FileChanged(dtmp);
 		}
 	} while (++dir);
 }
@@ -3860,23 +3974,20 @@ int Interface::SwapoutArea(Map *map) const
 	if (mm == nullptr) {
 		return -1;
 	}
-	int size = mm->GetStoredFileSize (map);
-	if (size > 0) {
+	// serialize into memory first, so the file is written in one go
+	BufferStream buffer(map->GetScriptName().c_str());
+	int ret = mm->PutArea(&buffer, map);
+	if (ret < 0) {
+		Log(WARNING, "Core", "Area removed: {}",
+			map->GetScriptName());
+		RemoveFromCache(map->GetScriptRef(), IE_ARE_CLASS_ID);
+	} else {
 		//created streams are always autofree (close file on destruct)
 		//this one will be destructed when we return from here
 		FileStream str;
 
 		str.Create(map->GetScriptName().c_str(), IE_ARE_CLASS_ID);
-		int ret = mm->PutArea (&str, map);
-		if (ret <0) {
-			Log(WARNING, "Core", "Area removed: {}",
-				map->GetScriptName());
-			RemoveFromCache(map->GetScriptRef(), IE_ARE_CLASS_ID);
-		}
-	} else {
-		Log(WARNING, "Core", "Area removed: {}",
-			map->GetScriptName());
-		RemoveFromCache(map->GetScriptRef(), IE_ARE_CLASS_ID);
+		buffer.WriteTo(str);
 	}
 	//make sure the stream isn't connected to sm, or it will be double freed
 	return 0;
@@ -3923,14 +4034,16 @@ int Interface::WriteGame(const char *folder)
 	if (size > 0) {
 		//created streams are always autofree (close file on destruct)
 		//this one will be destructed when we return from here
-		FileStream str;
-
-		str.Create(folder, GameNameResRef.c_str(), IE_GAM_CLASS_ID);
-		int ret = gm->PutGame (&str, game);
+		BufferStream buffer(GameNameResRef.c_str(), size);
+		int ret = gm->PutGame(&buffer, game);
 		if (ret <0) {
 			Log(WARNING, "Core", "Game cannot be saved: {}", folder);
 			return -1;
 		}
+
+		FileStream str;
+		str.Create(folder, GameNameResRef.c_str(), IE_GAM_CLASS_ID);
+		buffer.WriteTo(str);
 	} else {
 		Log(WARNING, "Core", "Internal error, game cannot be saved: {}", folder);
 		return -1;
@@ -336,11 +336,16 @@ struct CFGConfigData {
 	int Height = 480;
 	int Bpp = 32;
 	bool DrawFPS = false;
+	bool Headless = false; // fast-forward simulation, detached from the wall clock
+	int HeadlessDrawInterval = 0; // in headless mode draw only every Nth tick (0 = never)
 	int debugMode = 0;
 	bool CheatFlag = false; /** Cheats enabled? */
 	int MaxPartySize = 6;
 
 	bool KeepCache = false;
+	bool CacheCompressedBIFs = false; // decompress whole BIFC archives into the cache instead of on demand
+	int ResidentCacheSize = 4096; // KiB of unused items, spells and effects kept parsed
+	int ScriptBudget = 8; // routine script rounds per area and tick (0 = unlimited)
 	bool MultipleQuickSaves = false;
 	// once GemRB own format is working well, this might be set to 0
 	int SaveAsOriginal = 1; // if true, saves files in compatible mode
@@ -469,6 +474,8 @@ public:
 	/* returns a newly created string */
 	String GetString(ieStrRef strref, STRING_FLAGS options = STRING_FLAGS::NONE) const;
 	std::string GetMBString(ieStrRef strref, STRING_FLAGS options = STRING_FLAGS::NONE) const;
+	/** decodes the strings ahead of time, for screens that show many of them */
+	void PrefetchStrings(const std::vector<ieStrRef>& strrefs) const;
 	/* sets the floattext color */
 	void SetInfoTextColor(const Color &color);
 	/** returns a gradient set */
@@ -36,6 +36,7 @@
 #include "Palette.h"
 #include "Particles.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "Projectile.h"
 #include "SaveGameIterator.h"
 #include "ScriptedAnimation.h"
@@ -55,12 +56,57 @@
 #include <array>
 #include <cassert>
 #include <limits>
+#include <map>
 #include <utility>
 #include <unordered_map>
 
 namespace GemRB {
 
 static constexpr unsigned int MAX_CIRCLESIZE = 8;
+// GetBlockedInRadiusTile checks circles of radius 0 to MAX_CIRCLESIZE - 2
+static constexpr uint8_t MAX_CLEARANCE = MAX_CIRCLESIZE - 1;
+
+// the rows of a filled PlotCircle, relative to its center
+struct CircleSpan {
+	int dy;
+	int x1;
+	int x2;
+};
+using CircleStencil = std::vector<CircleSpan>;
+
+static const CircleStencil& GetCircleStencil(uint16_t r)
+{
+	static const auto stencils = [] {
+		std::array<CircleStencil, MAX_CIRCLESIZE> tables;
+		for (uint16_t radius = 0; radius < MAX_CIRCLESIZE; ++radius) {
+			// PlotCircle gives pairs of points on the same row and may repeat
+			// rows, so merge them into one span per row
+			std::map<int, CircleSpan> rows;
+			const auto points = PlotCircle(Point(), radius);
+			for (size_t i = 0; i < points.size(); i += 2) {
+				const Point& p1 = points[i];
+				const Point& p2 = points[i + 1];
+				assert(p1.y == p2.y);
+				assert(p2.x <= p1.x);
+
+				auto it = rows.find(p1.y);
+				if (it == rows.end()) {
+					rows.emplace(p1.y, CircleSpan { p1.y, p2.x, p1.x });
+				} else {
+					it->second.x1 = std::min(it->second.x1, p2.x);
+					it->second.x2 = std::max(it->second.x2, p1.x);
+				}
+			}
+			for (const auto& row : rows) {
+				tables[radius].push_back(row.second);
+			}
+		}
+		return tables;
+	}();
+
+	assert(r < MAX_CIRCLESIZE);
+	return stencils[r];
+}
 
 const PixelFormat TileProps::pixelFormat(0, 0, 0, 0,
 										 searchMapShift, materialMapShift,
@@ -77,6 +123,8 @@ TileProps::TileProps(Holder<Sprite2D> props) noexcept
 	
 	assert(propImage->Format().Bpp == 4);
 	assert(propImage->GetPitch() == size.w * 4);
+
+	clearance.assign(size.Area(), unknownClearance);
 }
 	
 const Size& TileProps::GetSize() const noexcept
@@ -92,6 +140,7 @@ void TileProps::SetTileProp(const Point& p, Property prop, uint8_t val) noexcept
 			case Property::SEARCH_MAP:
 				c &= ~searchMapMask;
 				c |= val << searchMapShift;
+				InvalidateClearance(p, 0);
 				break;
 			case Property::MATERIAL:
 				c &= ~materialMapMask;
@@ -142,6 +191,50 @@ PathMapFlags TileProps::QuerySearchMap(const Point& p) const noexcept
 	return static_cast<PathMapFlags>(QueryTileProp(p, Property::SEARCH_MAP));
 }
 
+uint8_t TileProps::ComputeClearance(const Point& p) const noexcept
+{
+	uint8_t r = 0;
+	for (; r < MAX_CLEARANCE; ++r) {
+		for (const CircleSpan& span : GetCircleStencil(r)) {
+			for (int x = span.x1; x <= span.x2; ++x) {
+				if (QuerySearchMap(p + Point(x, span.dy)) != PathMapFlags::PASSABLE) {
+					return r;
+				}
+			}
+		}
+	}
+	return r;
+}
+
+void TileProps::InvalidateClearance(const Point& p, int radius) const noexcept
+{
+	// any circle reaching a changed cell has its center this close to it
+	int reach = radius + MAX_CLEARANCE - 1;
+	int x1 = std::max(p.x - reach, 0);
+	int x2 = std::min(p.x + reach, size.w - 1);
+	if (x1 > x2) return;
+
+	int y1 = std::max(p.y - reach, 0);
+	int y2 = std::min(p.y + reach, size.h - 1);
+	for (int y = y1; y <= y2; ++y) {
+		auto row = clearance.begin() + y * size.w;
+		std::fill(row + x1, row + x2 + 1, unknownClearance);
+	}
+}
+
+uint8_t TileProps::QueryClearance(const Point& p) const noexcept
+{
+	if (!size.PointInside(p)) {
+		return 0;
+	}
+
+	uint8_t& value = clearance[p.y * size.w + p.x];
+	if (value == unknownClearance) {
+		value = ComputeClearance(p);
+	}
+	return value;
+}
+
 uint8_t TileProps::QueryMaterial(const Point& p) const noexcept
 {
 	return QueryTileProp(p, Property::MATERIAL);
@@ -171,7 +264,11 @@ void TileProps::PaintSearchMap(const Point& p, PathMapFlags value) const noexcep
 	}
 	
 	uint32_t& pixel = propPtr[p.y * size.w + p.x];
-	pixel = (pixel & ~searchMapMask) | (uint32_t(value) << propImage->Format().Rshift);
+	uint32_t newPixel = (pixel & ~searchMapMask) | (uint32_t(value) << propImage->Format().Rshift);
+	if (newPixel != pixel) {
+		pixel = newPixel;
+		InvalidateClearance(p, 0);
+	}
 }
 
 // Valid values are - PathMapFlags::UNMARKED, PathMapFlags::PC, PathMapFlags::NPC
@@ -185,31 +282,31 @@ void TileProps::PaintSearchMap(const Point& Pos, uint16_t blocksize, const PathM
 	// This means that an actor can get closer to a wall than to another
 	// actor. This matches the behaviour of the original BG2.
 	
-	auto PaintIfPassable = [this, value](const Point& pos)
+	bool changed = false;
+	auto PaintIfPassable = [this, value, &changed](const Point& pos)
 	{
 		PathMapFlags mapval = QuerySearchMap(pos);
 		if (mapval != PathMapFlags::IMPASSABLE) {
 			PathMapFlags newVal = (mapval & PathMapFlags::NOTACTOR) | value;
+			if (newVal == mapval) return;
 			uint32_t& pixel = propPtr[pos.y * size.w + pos.x];
 			pixel = (pixel & ~searchMapMask) | (uint32_t(newVal) << propImage->Format().Rshift);
+			changed = true;
 		}
 	};
 
 	blocksize = Clamp<uint16_t>(blocksize, 1, MAX_CIRCLESIZE);
 	uint16_t r = blocksize - 1;
 	
-	const auto points = PlotCircle(Pos, r);
-	for (size_t i = 0; i < points.size(); i += 2)
-	{
-		const Point& p1 = points[i];
-		const Point& p2 = points[i + 1];
-		assert(p1.y == p2.y);
-		assert(p2.x <= p1.x);
-		
-		for (int x = p2.x; x <= p1.x; ++x) {
-			PaintIfPassable(Point(x, p1.y));
+	for (const CircleSpan& span : GetCircleStencil(r)) {
+		for (int x = span.x1; x <= span.x2; ++x) {
+			PaintIfPassable(Pos + Point(x, span.dy));
 		}
 	}
+
+	if (changed) {
+		InvalidateClearance(Pos, r);
+	}
 }
 
 #define YESNO(x) ( (x)?"Yes":"No")
@@ -657,6 +754,8 @@ void Map::DrawPortal(const InfoPoint *ip, int enable)
 
 void Map::UpdateScripts()
 {
+	PROFILE_SCOPE(MapScripts);
+	scriptScheduler.NewTick();
 	bool has_pcs = false;
 	for (const auto& actor : actors) {
 		if (actor->InParty) {
@@ -752,7 +851,7 @@ void Map::UpdateScripts()
 		 * doing this differently (for example by storing the cutscene state at the
 		 * start of this function, or by changing the cutscene state at a later
 		 * point, etc), but i did it this way for now because it seems least painful
-		 * and we should probably be staggering the script executions anyway
+		 * (the script rounds themselves are staggered by scriptScheduler)
 		 */
 		actor->Update();
 		actor->UpdateActorState();
@@ -764,10 +863,9 @@ void Map::UpdateScripts()
 				actor->NewPath();
 			}
 		} else if (actor->GetStep() && actor->GetSpeed()) {
-			// Make actors pathfind if there are others nearby
-			// in order to avoid bumping when possible
-			const Actor* nearActor = GetActorInRadius(actor->Pos, GA_NO_DEAD|GA_NO_UNSCHEDULED, actor->GetAnims()->GetCircleSize());
-			if (nearActor && nearActor != actor) {
+			// DoStep steers around nearby actors on its own, only
+			// pathfind again when that keeps failing
+			if (actor->IsSteeringStuck()) {
 				actor->NewPath();
 			}
 			DoStepForActor(actor, time);
@@ -914,7 +1012,7 @@ void Map::BlockSearchMapFor(const Movable *actor) const
 
 void Map::ClearSearchMapFor(const Movable *actor) const
 {
-	std::vector<Actor *> nearActors = GetAllActorsInRadius(actor->Pos, GA_NO_SELF|GA_NO_DEAD|GA_NO_LOS|GA_NO_UNSCHEDULED, MAX_CIRCLE_SIZE*3, actor);
+	FrameVector<Actor*> nearActors = GetAllActorsInRadius(actor->Pos, GA_NO_SELF|GA_NO_DEAD|GA_NO_LOS|GA_NO_UNSCHEDULED, MAX_CIRCLE_SIZE*3, actor);
 	tileProps.PaintSearchMap(ConvertCoordToTile(actor->Pos), actor->circleSize, PathMapFlags::UNMARKED);
 
 	// Restore the searchmap areas of any nearby actors that could
@@ -949,7 +1047,7 @@ bool Map::FogTileUncovered(const Point &p, const Bitmap* mask) const
 	return mask->GetAt(p, false);
 }
 
-void Map::DrawFogOfWar(const Bitmap* explored_mask, const Bitmap* visible_mask, const Region& vp) const
+void Map::DrawFogOfWar(const Bitmap* explored_mask, const Bitmap* visible_mask, const Region& vp)
 {
 	// Size of Fog-Of-War shadow tile (and bitmap)
 	constexpr int CELL_SIZE = 32;
@@ -1035,9 +1133,12 @@ void Map::DrawFogOfWar(const Bitmap* explored_mask, const Bitmap* visible_mask,
 		return FogTileUncovered(Point(x, y), visible_mask);
 	};
 	
-	auto ConvertPointToScreen = [=](int x, int y) {
-		x = (x - start.x) * CELL_SIZE + x0;
-		y = (y - start.y) * CELL_SIZE + y0;
+	// cells are drawn into the fog layer relative to the first cell of the run being drawn
+	Point runCell;
+	Point runOrigin;
+	auto ConvertPointToScreen = [&](int x, int y) {
+		x = (x - runCell.x) * CELL_SIZE + runOrigin.x;
+		y = (y - runCell.y) * CELL_SIZE + runOrigin.y;
 		return Point(x, y);
 	};
 	
@@ -1131,47 +1232,149 @@ void Map::DrawFogOfWar(const Bitmap* explored_mask, const Bitmap* visible_mask,
 		}
 	};
 
-	for (int y = start.y; y < end.y; y++) {
-		int unexploredQueue = 0;
-		int shroudedQueue = 0;
-		int x = start.x;
-		for (; x < end.x; x++) {
-			if (IsExplored(x, y)) {
-				if (unexploredQueue) {
-					FillFog(x - unexploredQueue, y, unexploredQueue, opaque);
-					unexploredQueue = 0;
-				}
+	auto DrawCells = [&](const Region& cells, const Point& origin) {
+		runCell = cells.origin;
+		runOrigin = origin;
+		for (int y = cells.y; y < cells.y + cells.h; y++) {
+			int unexploredQueue = 0;
+			int shroudedQueue = 0;
+			int x = cells.x;
+			for (; x < cells.x + cells.w; x++) {
+				if (IsExplored(x, y)) {
+					if (unexploredQueue) {
+						FillFog(x - unexploredQueue, y, unexploredQueue, opaque);
+						unexploredQueue = 0;
+					}
+				
+					if (IsVisible(x, y)) {
+						if (shroudedQueue) {
+							FillFog(x - shroudedQueue, y, shroudedQueue, trans);
+							shroudedQueue = 0;
+						}
+						FillVisible(x, y);
+					} else {
+						// coalese all horizontally adjacent shrouded cells
+						++shroudedQueue;
+					}
 				
-				if (IsVisible(x, y)) {
+					FillExplored(x, y);
+				} else {
+					// coalese all horizontally adjacent unexplored cells
+					++unexploredQueue;
 					if (shroudedQueue) {
 						FillFog(x - shroudedQueue, y, shroudedQueue, trans);
 						shroudedQueue = 0;
 					}
-					FillVisible(x, y);
-				} else {
-					// coalese all horizontally adjacent shrouded cells
-					++shroudedQueue;
-				}
-				
-				FillExplored(x, y);
-			} else {
-				// coalese all horizontally adjacent unexplored cells
-				++unexploredQueue;
-				if (shroudedQueue) {
-					FillFog(x - shroudedQueue, y, shroudedQueue, trans);
-					shroudedQueue = 0;
 				}
 			}
-		}
 		
-		if (shroudedQueue) {
-			FillFog(x - (shroudedQueue + unexploredQueue), y, shroudedQueue, trans);
-		}
+			if (shroudedQueue) {
+				FillFog(x - (shroudedQueue + unexploredQueue), y, shroudedQueue, trans);
+			}
 		
-		if (unexploredQueue) {
-			FillFog(x - unexploredQueue, y, unexploredQueue, opaque);
+			if (unexploredQueue) {
+				FillFog(x - unexploredQueue, y, unexploredQueue, opaque);
+			}
 		}
+	};
+
+	const Region cells(start, Size(end.x - start.x, end.y - start.y));
+	if (cells.size.IsInvalid()) {
+		return;
 	}
+
+	// the cells are rendered into a layer a few cells larger than the viewport, which is
+	// then composited with a single blit; afterwards only the cells whose bits (or those
+	// of their neighbours) changed are redrawn, so scrolling and idle frames stay cheap
+	constexpr int LAYER_MARGIN = 4;
+	bool rebuild = fogLayer.buffer == nullptr || !fogLayer.cells.RectInside(cells);
+	rebuild |= fogLayer.exploredMasked != (explored_mask != nullptr);
+	rebuild |= fogLayer.visibleMasked != (visible_mask != nullptr);
+
+	auto Unchanged = [](const Bitmap& snapshot, const Bitmap* mask) {
+		return mask == nullptr || (snapshot.GetSize() == mask->GetSize() && std::equal(mask->begin(), mask->end(), snapshot.begin()));
+	};
+
+	auto Snapshot = [](Bitmap& snapshot, const Bitmap* mask) {
+		if (mask == nullptr) {
+			return;
+		} else if (snapshot.GetSize() == mask->GetSize()) {
+			snapshot = *mask;
+		} else {
+			snapshot = Bitmap(*mask);
+		}
+	};
+
+	// the layer is larger than the screen, so the screen clip must not apply while drawing into it
+	const Region screenClip = vid->GetScreenClip();
+	const Region& layer = fogLayer.cells;
+	if (rebuild) {
+		const Size layerSize((cells.w + LAYER_MARGIN * 2) * CELL_SIZE, (cells.h + LAYER_MARGIN * 2) * CELL_SIZE);
+		if (fogLayer.buffer && fogLayer.buffer->Size() == layerSize) {
+			fogLayer.buffer->Clear();
+		} else {
+			fogLayer.buffer = vid->CreateBuffer(Region(Point(), layerSize), Video::BufferFormat::DISPLAY_ALPHA);
+		}
+
+		const Point margin(LAYER_MARGIN, LAYER_MARGIN);
+		const Point min = Clamp(cells.origin - margin, Point(), Point(fogSize.w, fogSize.h));
+		const Point max = Clamp(cells.Maximum() + margin, Point(), Point(fogSize.w, fogSize.h));
+		fogLayer.cells = Region(min, Size(max.x - min.x, max.y - min.y));
+		fogLayer.exploredMasked = explored_mask != nullptr;
+		fogLayer.visibleMasked = visible_mask != nullptr;
+
+		vid->PushDrawingBuffer(fogLayer.buffer);
+		vid->ClipToDrawingBuffer();
+		DrawCells(layer, Point());
+		vid->PopDrawingBuffer();
+		vid->SetScreenClip(&screenClip);
+		Snapshot(fogLayer.explored, explored_mask);
+		Snapshot(fogLayer.visible, visible_mask);
+	} else if (!Unchanged(fogLayer.explored, explored_mask) || !Unchanged(fogLayer.visible, visible_mask)) {
+		auto Changed = [&](int x, int y) {
+			const Point p(x, y);
+			if (explored_mask && explored_mask->GetAt(p, false) != fogLayer.explored.GetAt(p, false)) {
+				return true;
+			}
+			return visible_mask && visible_mask->GetAt(p, false) != fogLayer.visible.GetAt(p, false);
+		};
+
+		// a cell is drawn from its own bits and those of its 4 neighbours
+		auto Dirty = [&](int x, int y) {
+			return Changed(x, y) || Changed(x, y - 1) || Changed(x - 1, y) || Changed(x, y + 1) || Changed(x + 1, y);
+		};
+
+		vid->PushDrawingBuffer(fogLayer.buffer);
+		vid->ClipToDrawingBuffer();
+		for (int y = layer.y; y < layer.y + layer.h; ++y) {
+			int x = layer.x;
+			while (x < layer.x + layer.w) {
+				if (!Dirty(x, y)) {
+					++x;
+					continue;
+				}
+
+				// coalesce all horizontally adjacent dirty cells
+				int runEnd = x + 1;
+				while (runEnd < layer.x + layer.w && Dirty(runEnd, y)) {
+					++runEnd;
+				}
+
+				const Region run(x, y, runEnd - x, 1);
+				const Point origin((x - layer.x) * CELL_SIZE, (y - layer.y) * CELL_SIZE);
+				fogLayer.buffer->Clear(Region(origin, Size(run.w * CELL_SIZE, CELL_SIZE)));
+				DrawCells(run, origin);
+				x = runEnd;
+			}
+		}
+		vid->PopDrawingBuffer();
+		vid->SetScreenClip(&screenClip);
+		Snapshot(fogLayer.explored, explored_mask);
+		Snapshot(fogLayer.visible, visible_mask);
+	}
+
+	const Point origin((layer.x - start.x) * CELL_SIZE + x0, (layer.y - start.y) * CELL_SIZE + y0);
+	vid->BlitVideoBuffer(fogLayer.buffer, origin, BlitFlags::BLENDED);
 }
 
 void Map::DrawHighlightables(const Region& viewport) const
@@ -1341,9 +1544,74 @@ VEFObject *Map::GetNextScriptedAnimation(const scaIterator &iter) const
 	return *iter;
 }
 
+// apparently birds and the dead are always visible?
+bool Map::IsActorVisible(const Actor* actor) const
+{
+	if (!actor->HasDrawingState() || !IsExplored(actor->Pos)) {
+		return false;
+	}
+	return IsVisible(actor->Pos) || actor->Modified[IE_DONOTJUMP] & DNJ_BIRD || actor->GetInternalFlag() & IF_REALLYDIED;
+}
+
+// the per tick part of what used to happen while drawing, so it also runs
+// when the map isn't drawn (e.g. in headless mode)
+void Map::UpdateVisualEffects()
+{
+	ieDword gametime = core->GetGame()->GameTime;
+
+	//area specific spawn.ini files (a PST feature)
+	if (INISpawn) {
+		INISpawn->CheckSpawn();
+	}
+
+	int q = PR_DISPLAY;
+	size_t index = queue[q].size();
+	Actor* actor = GetNextActor(q, index);
+	while (actor) {
+		// always update the animations even if we arent visible
+		actor->UpdateDrawingState();
+		if (!IsActorVisible(actor) || (actor->GetInternalFlag() & (IF_REALLYDIED | IF_ACTIVE)) == (IF_REALLYDIED | IF_ACTIVE)) {
+			actor->SetInternalFlag(IF_TRIGGER_AP, BitOp::NAND);
+			// turning actor inactive if there is no action next turn
+			actor->HibernateIfAble();
+		}
+		actor = GetNextActor(q, index);
+	}
+
+	for (auto it = vvcCells.begin(); it != vvcCells.end();) {
+		if ((*it)->UpdateDrawingState(-1)) {
+			delete *it;
+			it = vvcCells.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	if (gametime > oldGameTime) {
+		for (auto it = projectiles.begin(); it != projectiles.end();) {
+			if ((*it)->Update()) {
+				++it;
+			} else {
+				delete *it;
+				it = projectiles.erase(it);
+			}
+		}
+		for (auto it = particles.begin(); it != particles.end();) {
+			if ((*it)->Update()) {
+				++it;
+			} else {
+				delete *it;
+				it = particles.erase(it);
+			}
+		}
+	}
+	oldGameTime = gametime;
+}
+
 //Draw the game area (including overlays, actors, animations, weather)
 void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 {
+	PROFILE_SCOPE(DrawMap);
 	assert(TMap);
 	debugFlags = dFlags;
 
@@ -1351,11 +1619,6 @@ void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 	ieDword gametime = game->GameTime;
 	bool timestop = game->IsTimestopActive();
 
-	//area specific spawn.ini files (a PST feature)
-	if (INISpawn) {
-		INISpawn->CheckSpawn();
-	}
-
 	// Map Drawing Strategy
 	// 1. Draw background
 	// 2. Draw overlays (weather)
@@ -1458,31 +1721,19 @@ void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 	while (actor || a || sca || spark || pro || pile) {
 		switch(SelectObject(actor,q,a,sca,spark,pro,pile)) {
 		case AOT_ACTOR:
-			bool visible;
-			visible = false;
-			// always update the animations even if we arent visible
-			if (actor->UpdateDrawingState() && IsExplored(actor->Pos)) {
-				// apparently birds and the dead are always visible?
-				visible = IsVisible(actor->Pos) || actor->Modified[IE_DONOTJUMP] & DNJ_BIRD || actor->GetInternalFlag() & IF_REALLYDIED;
-				if (visible) {
-					BlitFlags flags = SetDrawingStencilForScriptable(actor, viewport);
-					if (game->TimeStoppedFor(actor)) {
-						// when time stops, almost everything turns dull grey,
-						// the caster and immune actors being the most notable exceptions
-						flags |= BlitFlags::GREY;
-					}
-
-					Color baseTint = area->GetLighting(actor->Pos);
-					Color tint(baseTint);
-					game->ApplyGlobalTint(tint, flags);
-					actor->Draw(viewport, baseTint, tint, flags | BlitFlags::BLENDED);
+			// the animations were already advanced by UpdateVisualEffects
+			if (IsActorVisible(actor)) {
+				BlitFlags flags = SetDrawingStencilForScriptable(actor, viewport);
+				if (game->TimeStoppedFor(actor)) {
+					// when time stops, almost everything turns dull grey,
+					// the caster and immune actors being the most notable exceptions
+					flags |= BlitFlags::GREY;
 				}
-			}
 
-			if (!visible || (actor->GetInternalFlag() & (IF_REALLYDIED | IF_ACTIVE)) == (IF_REALLYDIED | IF_ACTIVE)) {
-				actor->SetInternalFlag(IF_TRIGGER_AP, BitOp::NAND);
-				// turning actor inactive if there is no action next turn
-				actor->HibernateIfAble();
+				Color baseTint = area->GetLighting(actor->Pos);
+				Color tint(baseTint);
+				game->ApplyGlobalTint(tint, flags);
+				actor->Draw(viewport, baseTint, tint, flags | BlitFlags::BLENDED);
 			}
 			actor = GetNextActor(q, index);
 			break;
@@ -1513,12 +1764,7 @@ void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 			a = DrawAreaAnimation(a);
 			break;
 		case AOT_SCRIPTED:
-			bool endReached;
-			endReached = sca->UpdateDrawingState(-1);
-			if (endReached) {
-				delete sca;
-				scaidx = vvcCells.erase(scaidx);
-			} else {
+			{
 				video->SetStencilBuffer(wallStencil);
 				Color tint = GetLighting(sca->Pos);
 				tint.a = 255;
@@ -1530,40 +1776,16 @@ void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 				}
 				game->ApplyGlobalTint(tint, flags);
 				sca->Draw(viewport, tint, 0, flags);
-				scaidx++;
 			}
-			sca = GetNextScriptedAnimation(scaidx);
+			sca = GetNextScriptedAnimation(++scaidx);
 			break;
 		case AOT_PROJECTILE:
-			int drawn;
-			if (gametime > oldGameTime) {
-				drawn = pro->Update();
-			} else {
-				drawn = 1;
-			}
-			if (drawn) {
-				pro->Draw(viewport);
-				proidx++;
-			} else {
-				delete pro;
-				proidx = projectiles.erase(proidx);
-			}
-			pro = GetNextProjectile(proidx);
+			pro->Draw(viewport);
+			pro = GetNextProjectile(++proidx);
 			break;
 		case AOT_SPARK:
-			if (gametime > oldGameTime) {
-				drawn = spark->Update();
-			} else {
-				drawn = 1;
-			}
-			if (drawn) {
-				spark->Draw(viewport.origin);
-				spaidx++;
-			} else {
-				delete spark;
-				spaidx = particles.erase(spaidx);
-			}
-			spark = GetNextSpark(spaidx);
+			spark->Draw(viewport.origin);
+			spark = GetNextSpark(++spaidx);
 			break;
 		default:
 			error("Map", "Trying to draw unknown animation type.");
@@ -1571,6 +1793,16 @@ void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 	}
 
 	video->SetStencilBuffer(NULL);
+
+	// drop the stencils of objects that were not drawn this frame (left the map or the viewport)
+	for (auto it = objectStencils.begin(); it != objectStencils.end();) {
+		if (it->second.used) {
+			it->second.used = false;
+			++it;
+		} else {
+			it = objectStencils.erase(it);
+		}
+	}
 	
 	bool update_scripts = (core->GetGameControl()->GetDialogueFlags() & DF_FREEZE_SCRIPTS) == 0;
 	game->DrawWeather(update_scripts);
@@ -1619,8 +1851,6 @@ void Map::DrawMap(const Region& viewport, uint32_t dFlags)
 		actors[i]->DrawOverheadText();
 	}
 
-	oldGameTime = gametime;
-
 	// Show wallpolygons
 	if (debugFlags & (DEBUG_SHOW_WALLS_ALL|DEBUG_SHOW_DOORS_DISABLED)) {
 		const auto& viewportWallsAll = WallsIntersectingRegion(viewport, true);
@@ -1685,8 +1915,8 @@ WallPolygonSet Map::WallsIntersectingRegion(Region r, bool includeDisabled, cons
 	uint32_t xmax = std::min(pitch, CeilDiv<uint32_t>(r.x + r.w, groupWidth));
 
 	WallPolygonSet set;
-	WallPolygonGroup& infront = set.first;
-	WallPolygonGroup& behind = set.second;
+	WallPolygonRefs& infront = set.first;
+	WallPolygonRefs& behind = set.second;
 
 	for (uint32_t y = ymin; y < ymax; ++y) {
 		for (uint32_t x = xmin; x < xmax; ++x) {
@@ -1713,6 +1943,12 @@ WallPolygonSet Map::WallsIntersectingRegion(Region r, bool includeDisabled, cons
 	return set;
 }
 
+// the cached stencils outlive the frame, so they keep their own copy of the walls
+static bool SameWalls(const WallPolygonGroup& cached, const WallPolygonRefs& walls)
+{
+	return cached.size() == walls.size() && std::equal(walls.begin(), walls.end(), cached.begin());
+}
+
 void Map::SetDrawingStencilForObject(const void* object, const Region& objectRgn, const WallPolygonSet& walls, const Point& viewPortOrigin)
 {
 	VideoBufferPtr stencil = nullptr;
@@ -1725,31 +1961,36 @@ void Map::SetDrawingStencilForObject(const void* object, const Region& objectRgn
 	if (behindWall && inFrontOfWall) {
 		// we need a custom stencil if both behind and in front of a wall
 		auto it = objectStencils.find(object);
-		if (it != objectStencils.end()) {
-			// we already made one
-			const auto& pair = it->second;
-			if (pair.second.RectInside(objectRgn)) {
-				// and it is still good
-				stencil = pair.first;
+		if (it != objectStencils.end() && objectRgn.w <= it->second.buffer->Size().w && objectRgn.h <= it->second.buffer->Size().h) {
+			// we already made one and it is big enough
+			ObjectStencil& cached = it->second;
+			stencil = cached.buffer;
+			stencil->SetOrigin(objectRgn.origin - viewPortOrigin);
+			cached.used = true;
+
+			// the stencil is relative to the object, so it only has to be redrawn
+			// if the object moved or a door changed the state of the walls over it
+			if (cached.region != objectRgn || !SameWalls(cached.walls, walls.first) || cached.wallEpoch != wallStateEpoch) {
+				stencil->Clear();
+				DrawStencil(stencil, objectRgn, walls.first);
+				cached.region = objectRgn;
+				cached.walls.assign(walls.first.begin(), walls.first.end());
+				cached.wallEpoch = wallStateEpoch;
 			}
-		}
-		
-		if (stencil == nullptr) {
+		} else {
 			Region stencilRgn = Region(objectRgn.origin - viewPortOrigin, objectRgn.size);
 			if (stencilRgn.size.IsInvalid()) {
 				stencil = wallStencil;
 			} else {
 				stencil = video->CreateBuffer(stencilRgn, Video::BufferFormat::DISPLAY_ALPHA);
 				DrawStencil(stencil, objectRgn, walls.first);
-				objectStencils[object] = std::make_pair(stencil, objectRgn);
+				ObjectStencil& cached = objectStencils[object];
+				cached.buffer = stencil;
+				cached.region = objectRgn;
+				cached.walls.assign(walls.first.begin(), walls.first.end());
+				cached.wallEpoch = wallStateEpoch;
+				cached.used = true;
 			}
-		} else {
-			// TODO: we only need to do this because a door might have changed state over us
-			// if we could detect that we could avoid doing this expensive operation
-			// we could add another wall flag to mark doors and then we only need to do this if one of the "walls" over us has that flag set
-			stencil->Clear();
-			stencil->SetOrigin(objectRgn.origin - viewPortOrigin);
-			DrawStencil(stencil, objectRgn, walls.first);
 		}
 		
 		debugColor = ColorRed;
@@ -2257,9 +2498,9 @@ Actor* Map::GetActorInRadius(const Point &p, int flags, unsigned int radius) con
 	return NULL;
 }
 
-std::vector<Actor *> Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see) const
+FrameVector<Actor*> Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see) const
 {
-	std::vector<Actor *> neighbours;
+	FrameVector<Actor*> neighbours;
 	for (auto actor : actors) {
 		if (!WithinRange(actor, p, radius)) {
 			continue;
@@ -2500,9 +2741,9 @@ Actor *Map::GetActorByScriptName(const ieVariable& name) const
 	return nullptr;
 }
 
-std::vector<Actor*> Map::GetActorsInRect(const Region& rgn, int excludeFlags) const
+FrameVector<Actor*> Map::GetActorsInRect(const Region& rgn, int excludeFlags) const
 {
-	std::vector<Actor*> actorlist;
+	FrameVector<Actor*> actorlist;
 	actorlist.reserve(actors.size());
 	for (auto actor : actors) {
 		if (!actor->ValidTarget(excludeFlags))
@@ -2626,17 +2867,15 @@ PathMapFlags Map::GetBlockedInRadiusTile(const Point &tp, uint16_t size, const b
 	PathMapFlags ret = PathMapFlags::IMPASSABLE;
 	size = Clamp<uint16_t>(size, 2, MAX_CIRCLESIZE);
 	uint16_t r = size - 2;
-	
-	const auto points = PlotCircle(tp, r);
-	for (size_t i = 0; i < points.size(); i += 2)
-	{
-		const Point& p1 = points[i];
-		const Point& p2 = points[i + 1];
-		assert(p1.y == p2.y);
-		assert(p2.x <= p1.x);
-		
-		for (int x = p2.x; x <= p1.x; ++x) {
-			PathMapFlags flags = GetBlockedTile(Point(x, p1.y));
+
+	// the whole circle is plain floor, nothing to combine
+	if (tileProps.QueryClearance(tp) > r) {
+		return PathMapFlags::PASSABLE;
+	}
+
+	for (const CircleSpan& span : GetCircleStencil(r)) {
+		for (int x = span.x1; x <= span.x2; ++x) {
+			PathMapFlags flags = GetBlockedTile(tp + Point(x, span.dy));
 			if (stopOnImpassable && flags == PathMapFlags::IMPASSABLE) {
 				return PathMapFlags::IMPASSABLE;
 			}
@@ -2696,18 +2935,15 @@ bool Map::IsWalkableTo(const Point &s, const Point &d, bool actorsAreBlocking, c
 	return bool(ret & mask);
 }
 
-void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
+void Map::RedrawScreenStencil(const Region& vp, const WallPolygonRefs& walls)
 {
-	// FIXME: how do we know if a door changed state?
-	// we need to redraw the stencil when that happens
-	// see TODO in Map::SetDrawingStencilForScriptable for another example of something that could use this
-
-	if (stencilViewport == vp) {
+	if (stencilViewport == vp && stencilEpoch == wallStateEpoch) {
 		assert(wallStencil);
 		return;
 	}
 
 	stencilViewport = vp;
+	stencilEpoch = wallStateEpoch;
 
 	if (wallStencil == NULL) {
 		// FIXME: this should be forced 8bit*4 color format
@@ -2722,7 +2958,7 @@ void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
 	DrawStencil(wallStencil, vp, walls);
 }
 
-void Map::DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const
+void Map::DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonRefs& walls) const
 {
 	Video* video = core->GetVideoDriver();
 
@@ -3012,6 +3248,7 @@ std::string Map::dump(bool show_actors) const
 	AppendFormat(buffer, "Weather: {}\n", YESNO(AreaType & AT_WEATHER ) );
 	AppendFormat(buffer, "Area Type: {}\n", AreaType & (AT_CITY|AT_FOREST|AT_DUNGEON) );
 	AppendFormat(buffer, "Can rest: {}\n", YESNO(core->GetGame()->CanPartyRest(REST_AREA)));
+	AppendFormat(buffer, "Script rounds last tick: {} run, {} deferred\n", scriptScheduler.Evaluated(), scriptScheduler.Deferred());
 
 	if (show_actors) {
 		buffer.append("\n");
@@ -3440,23 +3677,24 @@ void Map::ExploreTile(const Point &p, bool fogOnly)
 	}
 }
 
-void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+template <typename EXPLORE>
+void Map::CastVisibility(const Point &Pos, int range, int los, EXPLORE&& explore) const
 {
 	Point Tile;
-	const Explore& explore = Explore::Get();
+	const Explore& exploreData = Explore::Get();
 
-	if (range > explore.MaxVisibility) {
-		range = explore.MaxVisibility;
+	if (range > exploreData.MaxVisibility) {
+		range = exploreData.MaxVisibility;
 	}
-	int p = explore.VisibilityPerimeter;
+	int p = exploreData.VisibilityPerimeter;
 	while (p--) {
 		int Pass = 2;
 		bool block = false;
 		bool sidewall = false;
 		bool fogOnly = false;
 		for (int i=0;i<range;i++) {
-			Tile.x = Pos.x + explore.VisibilityMasks[i][p].x;
-			Tile.y = Pos.y + explore.VisibilityMasks[i][p].y;
+			Tile.x = Pos.x + exploreData.VisibilityMasks[i][p].x;
+			Tile.y = Pos.y + exploreData.VisibilityMasks[i][p].y;
 
 			if (los) {
 				if (!block) {
@@ -3478,14 +3716,58 @@ void Map::ExploreMapChunk(const Point &Pos, int range, int los)
 					if (!Pass) break;
 				}
 			}
-			ExploreTile(Tile, fogOnly);
+			explore(Tile, fogOnly);
 		}
 	}
 }
 
+void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+{
+	CastVisibility(Pos, range, los, [this](const Point& tile, bool fogOnly) {
+		ExploreTile(tile, fogOnly);
+	});
+}
+
+// recasts the vision of a single actor into its own bitmaps
+void Map::UpdateFootprint(VisibilityFootprint& footprint, const Point& Pos, int range) const
+{
+	if (footprint.lastByte >= footprint.firstByte) {
+		std::fill(footprint.explored.begin() + footprint.firstByte, footprint.explored.begin() + footprint.lastByte + 1, 0);
+		std::fill(footprint.visible.begin() + footprint.firstByte, footprint.visible.begin() + footprint.lastByte + 1, 0);
+	}
+
+	const Size fogSize = FogMapSize();
+	int firstBit = fogSize.w * fogSize.h;
+	int lastBit = -1;
+	CastVisibility(Pos, range, 1, [&](const Point& tile, bool fogOnly) {
+		Point fogP = ConvertPointToFog(tile);
+		if (!fogSize.PointInside(fogP)) {
+			return;
+		}
+
+		int bit = fogP.y * fogSize.w + fogP.x;
+		footprint.explored[bit] = true;
+		if (!fogOnly) {
+			footprint.visible[bit] = true;
+		}
+		firstBit = std::min(firstBit, bit);
+		lastBit = std::max(lastBit, bit);
+	});
+
+	footprint.pos = Pos;
+	footprint.range = range;
+	footprint.doorEpoch = doorStateEpoch;
+	footprint.firstByte = lastBit < 0 ? 0 : firstBit / 8;
+	footprint.lastByte = lastBit < 0 ? -1 : lastBit / 8;
+}
+
 void Map::UpdateFog()
 {
+	PROFILE_SCOPE(Fog);
 	VisibleBitmap.fill(0);
+	for (auto& entry : visibilityCache) {
+		entry.second.used = false;
+	}
 	
 	std::set<Spawn*> potentialSpawns;
 	for (const auto actor : actors) {
@@ -3496,13 +3778,38 @@ void Map::UpdateFog()
 		
 		int vis2 = actor->Modified[IE_VISUALRANGE];
 		if ((state&STATE_BLIND) || (vis2<2)) vis2=2; //can see only themselves
-		ExploreMapChunk (actor->Pos, vis2+actor->GetAnims()->GetCircleSize(), 1);
+		int range = vis2 + actor->GetAnims()->GetCircleSize();
+
+		// only recast the vision of actors that moved or had their view changed
+		auto it = visibilityCache.find(actor->GetGlobalID());
+		if (it == visibilityCache.end()) {
+			it = visibilityCache.emplace(actor->GetGlobalID(), VisibilityFootprint(FogMapSize())).first;
+		}
+		VisibilityFootprint& footprint = it->second;
+		if (footprint.pos != actor->Pos || footprint.range != range || footprint.doorEpoch != doorStateEpoch) {
+			UpdateFootprint(footprint, actor->Pos, range);
+		}
+		footprint.used = true;
+
+		if (footprint.lastByte >= footprint.firstByte) {
+			VisibleBitmap.Merge(footprint.visible, footprint.firstByte, footprint.lastByte);
+			ExploredBitmap.Merge(footprint.explored, footprint.firstByte, footprint.lastByte);
+		}
 		
 		Spawn *sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
 		if (sp) {
 			potentialSpawns.insert(sp);
 		}
 	}
+
+	// forget actors that left, died or stopped exploring
+	for (auto it = visibilityCache.begin(); it != visibilityCache.end();) {
+		if (it->second.used) {
+			++it;
+		} else {
+			it = visibilityCache.erase(it);
+		}
+	}
 	
 	for (Spawn* spawn : potentialSpawns) {
 		TriggerSpawn(spawn);
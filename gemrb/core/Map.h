@@ -25,6 +25,8 @@
 #include "globals.h"
 
 #include "Bitmap.h"
+#include "FrameArena.h"
+#include "GameScript/ScriptScheduler.h"
 #include "Interface.h"
 #include "MapReverb.h"
 #include "Scriptable/Scriptable.h"
@@ -34,6 +36,7 @@
 #include <algorithm>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 template <class V> class FibonacciHeap;
 
@@ -347,6 +350,15 @@ class GEM_EXPORT TileProps {
 	static constexpr uint32_t heightMapShift = 8;
 	static constexpr uint32_t lightMapShift = 0;
 
+	// per cell count of the GetBlockedInRadiusTile circles (by radius) around it
+	// that are PASSABLE and nothing else, so most size checks become a compare
+	// filled in on demand and reset around every searchmap change
+	mutable std::vector<uint8_t> clearance;
+	static constexpr uint8_t unknownClearance = 0xff;
+
+	uint8_t ComputeClearance(const Point& p) const noexcept;
+	void InvalidateClearance(const Point& p, int radius) const noexcept;
+
 public:
 	static const PixelFormat pixelFormat;
 	
@@ -370,6 +382,7 @@ public:
 	uint8_t QueryTileProp(const Point& p, Property prop) const noexcept;
 	
 	PathMapFlags QuerySearchMap(const Point& p) const noexcept;
+	uint8_t QueryClearance(const Point& p) const noexcept;
 	uint8_t QueryMaterial(const Point& p) const noexcept;
 	int QueryElevation(const Point& p) const noexcept;
 	Color QueryLighting(const Point& p) const noexcept;
@@ -426,8 +439,52 @@ private:
 
 	VideoBufferPtr wallStencil = nullptr;
 	Region stencilViewport;
+	// bumped whenever a wall polygon is enabled or disabled, invalidating the stencils
+	unsigned int wallStateEpoch = 0;
+	unsigned int stencilEpoch = 0;
+
+	struct ObjectStencil {
+		VideoBufferPtr buffer;
+		Region region;
+		WallPolygonGroup walls;
+		unsigned int wallEpoch = 0;
+		// whether the object was drawn this frame, the others are evicted
+		bool used = true;
+	};
+	std::unordered_map<const void*, ObjectStencil> objectStencils;
+
+	// the rendered fog cells around the viewport, composited with a single blit
+	struct FogLayer {
+		VideoBufferPtr buffer = nullptr;
+		Region cells; // in fog cell coordinates
+		// the masks the buffer was last rendered from
+		Bitmap explored { Size() };
+		Bitmap visible { Size() };
+		bool exploredMasked = true;
+		bool visibleMasked = true;
+	} fogLayer;
+
+	// what an exploring actor sees, reused by UpdateFog until its inputs change
+	struct VisibilityFootprint {
+		Point pos;
+		int range = -1;
+		unsigned int doorEpoch = 0;
+		Bitmap explored;
+		Bitmap visible;
+		// the byte range of the bitmaps that contains any set bit
+		int firstByte = 0;
+		int lastByte = -1;
+		bool used = false;
+
+		explicit VisibilityFootprint(const Size& fogSize) noexcept
+		: explored(fogSize, uint8_t(0)), visible(fogSize, uint8_t(0)) {}
+	};
+	std::unordered_map<ieDword, VisibilityFootprint> visibilityCache;
+	// bumped whenever doors change the search map, invalidating the footprints
+	unsigned int doorStateEpoch = 0;
 
-	std::unordered_map<const void*, std::pair<VideoBufferPtr, Region>> objectStencils;
+	// spreads the script rounds of the actors, doors etc. over the ticks
+	ScriptScheduler scriptScheduler;
 
 	class MapReverb {
 	public:
@@ -470,6 +527,7 @@ public:
 	/** prints useful information on console */
 	std::string dump(bool show_actors = false) const;
 	TileMap *GetTileMap() const { return TMap; }
+	ScriptScheduler& GetScriptScheduler() { return scriptScheduler; }
 	/* gets the signal of daylight changes */
 	bool ChangeMap(bool day_or_night);
 	void SeeSpellCast(Scriptable *caster, ieDword spell) const;
@@ -484,6 +542,8 @@ public:
 	/* transfers all ever visible piles (loose items) to the specified position */
 	void MoveVisibleGroundPiles(const Point &Pos);
 
+	/* advances projectiles, sparks and animations, whether the map is drawn or not */
+	void UpdateVisualEffects();
 	void DrawMap(const Region& viewport, uint32_t debugFlags);
 	void PlayAreaSong(int SongType, bool restart = true, bool hard = false) const;
 	void AddAnimation(AreaAnimation anim);
@@ -537,9 +597,10 @@ public:
 	InfoPoint *GetInfoPointByGlobalID(ieDword objectID) const;
 	Actor* GetActorByGlobalID(ieDword objectID) const;
 	Actor* GetActorInRadius(const Point &p, int flags, unsigned int radius) const;
-	std::vector<Actor *> GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see = NULL) const;
+	// the results live in the FrameArena, don't keep them around
+	FrameVector<Actor*> GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see = NULL) const;
 	const std::vector<Actor *> &GetAllActors() const { return actors; }
-	std::vector<Actor*> GetActorsInRect(const Region& rgn, int excludeFlags) const;
+	FrameVector<Actor*> GetActorsInRect(const Region& rgn, int excludeFlags) const;
 	Actor* GetActor(const ieVariable& Name, int flags) const;
 	Actor* GetActor(int i, bool any) const;
 	Actor* GetActor(const Point &p, int flags, const Movable *checker = NULL) const;
@@ -610,6 +671,10 @@ public:
 	void ClearSearchMapFor(const Movable *actor) const;
 	/* update VisibleBitmap by resolving vision of all explore actors */
 	void UpdateFog();
+	/* doors changed line of sight, so cached visibility has to be recomputed */
+	void DoorStateChanged() { ++doorStateEpoch; }
+	/* a wall polygon was enabled or disabled, so the cached wall stencils are stale */
+	void WallStateChanged() { ++wallStateEpoch; }
 	//PathFinder
 	/* Finds the nearest passable point */
 	void AdjustPosition(Point &goal, int radiusx = 0, int radiusy = 0, int size = -1) const;
@@ -691,9 +756,11 @@ private:
 	VEFObject *GetNextScriptedAnimation(const scaIterator &iter) const;
 	Actor *GetNextActor(int &q, size_t &index) const;
 	Container *GetNextPile (int &index) const;
+	bool IsActorVisible(const Actor* actor) const;
 	
-	void RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls);
-	void DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const;
+	void RedrawScreenStencil(const Region& vp, const WallPolygonRefs& walls);
+	void DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonRefs& walls) const;
+	// the result lives in the FrameArena
 	WallPolygonSet WallsIntersectingRegion(Region, bool includeDisabled = false, const Point* loc = nullptr) const;
 	
 	void SetDrawingStencilForObject(const void*, const Region&, const WallPolygonSet&, const Point& viewPortOrigin);
@@ -703,12 +770,15 @@ private:
 	void DrawDebugOverlay(const Region &vp, uint32_t dFlags) const;
 	void DrawPortal(const InfoPoint *ip, int enable);
 	void DrawHighlightables(const Region& viewport) const;
-	void DrawFogOfWar(const Bitmap* explored_mask, const Bitmap* visible_mask, const Region& viewport) const;
+	void DrawFogOfWar(const Bitmap* explored_mask, const Bitmap* visible_mask, const Region& viewport);
 	
 	Size PropsSize() const noexcept;
 	Size FogMapSize() const;
 	bool FogTileUncovered(const Point &p, const Bitmap*) const;
 	Point ConvertPointToFog(const Point &p) const;
+	template <typename EXPLORE>
+	void CastVisibility(const Point &Pos, int range, int los, EXPLORE&& explore) const;
+	void UpdateFootprint(VisibilityFootprint& footprint, const Point& Pos, int range) const;
 	
 	void GenerateQueues();
 	void SortQueues();
@@ -43,8 +43,8 @@ public:
 	virtual bool ChangeMap(Map *map, bool day_or_night) = 0;
 	virtual Map* GetMap(const ResRef& ResRef, bool day_or_night) = 0;
 
-	virtual int GetStoredFileSize(Map *map) = 0;
-	virtual int PutArea(DataStream* stream, const Map *map) const = 0;
+	// serializes the area in one pass, seeking back to fill in the header
+	virtual int PutArea(DataStream* stream, Map *map) = 0;
 };
 
 }
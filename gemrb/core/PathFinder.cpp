@@ -38,6 +38,7 @@
 #include "GameData.h"
 #include "Map.h"
 #include "PathFinder.h"
+#include "Profiler.h"
 #include "RNG.h"
 #include "Scriptable/Actor.h"
 
@@ -300,6 +301,7 @@ PathListNode *Map::GetLine(const Point &p, int steps, orient_t orient) const
 // target (the goal must be in sight of the end, if PF_SIGHT is specified)
 PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, unsigned int minDistance, int flags, const Actor *caller) const
 {
+	PROFILE_SCOPE(Pathfinding);
 	if (core->InDebugMode(ID_PATHFINDER)) Log(DEBUG, "FindPath", "s = {}, d = {}, caller = {}, dist = {}, size = {}", s, d, caller ? MBStringFromString(caller->GetShortName()) : "nullptr", minDistance, size);
 	
 	// TODO: we could optimize this function further by doing everything in SearchmapPoint and converting at the end
@@ -371,13 +371,18 @@ bool Wall_Polygon::PointBehind(const Point &p) const
 	return true;
 }
 
-void Wall_Polygon::SetDisabled(bool disabled)
+bool Wall_Polygon::SetDisabled(bool disabled)
 {
+	if (bool(wall_flag & WF_DISABLED) == disabled) {
+		return false;
+	}
+
 	if (disabled) {
 		wall_flag |= WF_DISABLED;
 	} else {
 		wall_flag &= ~WF_DISABLED;
 	}
+	return true;
 }
 
 }
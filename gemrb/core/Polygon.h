@@ -19,6 +19,7 @@
 #ifndef POLYGON_H
 #define POLYGON_H
 
+#include "FrameArena.h"
 #include "RGBAColor.h"
 #include "exports.h"
 #include "globals.h"
@@ -83,7 +84,8 @@ public:
 	void SetPolygonFlag(ieDword flg) { wall_flag=flg; }
 	void SetBaseline(const Point &a, const Point &b);
 
-	void SetDisabled(bool disabled);
+	// returns true if the state actually changed
+	bool SetDisabled(bool disabled);
 	
 public:
 	ieDword wall_flag = 0;
@@ -91,8 +93,10 @@ public:
 };
 
 using WallPolygonGroup = std::vector<std::shared_ptr<Wall_Polygon>>;
+// a transient selection of walls, only valid for the current frame
+using WallPolygonRefs = FrameVector<std::shared_ptr<Wall_Polygon>>;
 // the first of the pair are the walls in front, the second are the walls behind
-using WallPolygonSet = std::pair<WallPolygonGroup, WallPolygonGroup>;
+using WallPolygonSet = std::pair<WallPolygonRefs, WallPolygonRefs>;
 
 }
 
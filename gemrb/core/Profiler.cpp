@@ -0,0 +1,160 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2022 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "Profiler.h"
+
+#include "Interface.h"
+#include "GUI/TextSystem/Font.h"
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+#include "Video/Video.h"
+
+namespace GemRB {
+
+// don't let a forgotten trace eat all memory, ~6MB; older events get overwritten
+static constexpr size_t MaxTraceEvents = 1 << 18;
+// a full histogram row corresponds to this many microseconds
+static constexpr Profiler::usec_t RowBudget = 33333;
+
+std::array<Profiler::ZoneHistory, size_t(ProfileZone::count)> Profiler::history {};
+size_t Profiler::frame = 0;
+std::vector<Profiler::TraceEvent> Profiler::trace;
+size_t Profiler::traceHead = 0;
+bool Profiler::enabled = false;
+
+const char* Profiler::ZoneName(ProfileZone zone)
+{
+	static const char* names[] = {
+		"Game::UpdateScripts", "Map::UpdateScripts", "Map::UpdateFog",
+		"Map::FindPath", "GameScript::Update", "EffectQueue::ApplyAllEffects",
+		"Map::DrawMap", "TileOverlay::Draw", "WindowManager::DrawWindows"
+	};
+	static_assert(sizeof(names) / sizeof(names[0]) == size_t(ProfileZone::count), "Missing profiler zone name.");
+	return names[size_t(zone)];
+}
+
+void Profiler::Enable(bool enable)
+{
+	if (enable && !enabled) {
+		history = {};
+		trace.clear();
+		trace.reserve(4096);
+		traceHead = 0;
+	}
+	enabled = enable;
+}
+
+void Profiler::Record(ProfileZone zone, usec_t start, usec_t end)
+{
+	usec_t duration = end - start;
+	history[size_t(zone)][frame] += duration;
+
+	if (trace.size() < MaxTraceEvents) {
+		trace.push_back({ start, duration, zone });
+	} else {
+		trace[traceHead] = { start, duration, zone };
+		traceHead = (traceHead + 1) % MaxTraceEvents;
+	}
+}
+
+void Profiler::NextFrame()
+{
+	if (!enabled) return;
+
+	frame = (frame + 1) % HistoryFrames;
+	for (auto& zoneHistory : history) {
+		zoneHistory[frame] = 0;
+	}
+}
+
+void Profiler::Draw(const Region& rgn)
+{
+	if (!enabled) return;
+
+	Video* video = core->GetVideoDriver();
+	const Font* font = core->GetTextFont();
+	int rowHeight = font->LineHeight + 2;
+	int labelWidth = 200;
+	int barWidth = 2;
+
+	Region bg(rgn.origin, Size(labelWidth + HistoryFrames * barWidth + 150, rowHeight * int(ProfileZone::count)));
+	video->DrawRect(bg, Color(0, 0, 0, 0xa0), true, BlitFlags::BLENDED);
+
+	for (size_t zone = 0; zone < size_t(ProfileZone::count); ++zone) {
+		const ZoneHistory& zoneHistory = history[zone];
+		int y = rgn.y + int(zone) * rowHeight;
+
+		const char* name = ZoneName(ProfileZone(zone));
+		Region label(rgn.x + 2, y, labelWidth, rowHeight);
+		font->Print(label, String(name, name + strlen(name)), IE_FONT_ALIGN_LEFT | IE_FONT_SINGLE_LINE);
+
+		usec_t total = 0;
+		usec_t peak = 0;
+		// oldest frame first; the current (incomplete) frame is skipped
+		for (size_t i = 1; i < HistoryFrames; ++i) {
+			usec_t value = zoneHistory[(frame + i) % HistoryFrames];
+			total += value;
+			peak = std::max(peak, value);
+
+			int h = int(std::min(value, RowBudget) * (rowHeight - 2) / RowBudget);
+			if (!h) continue;
+			Region bar(rgn.x + labelWidth + int(i) * barWidth, y + rowHeight - 1 - h, barWidth, h);
+			video->DrawRect(bar, value > RowBudget / 2 ? ColorRed : ColorGreen);
+		}
+
+		String stats = fmt::format(L"{:.2f} / {:.2f} ms", total / 1000.0 / (HistoryFrames - 1), peak / 1000.0);
+		Region text(rgn.x + labelWidth + HistoryFrames * barWidth + 4, y, 146, rowHeight);
+		font->Print(text, stats, IE_FONT_ALIGN_LEFT | IE_FONT_SINGLE_LINE);
+	}
+}
+
+bool Profiler::DumpTrace(const char* filename)
+{
+	FileStream out;
+	if (!out.Create(filename)) {
+		Log(ERROR, "Profiler", "Unable to create trace file {}!", filename);
+		return false;
+	}
+
+	// events are recorded when their scope ends, so an outer scope can start before the first event
+	usec_t base = trace.empty() ? 0 : trace.front().start;
+	for (const TraceEvent& event : trace) {
+		base = std::min(base, event.start);
+	}
+	std::string json = "{\"traceEvents\":[\n";
+	for (size_t i = 0; i < trace.size(); ++i) {
+		// oldest first
+		const TraceEvent& event = trace[(traceHead + i) % trace.size()];
+		json += fmt::format("{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":{},\"dur\":{}}}{}\n",
+							ZoneName(event.zone), event.start - base, event.duration, i + 1 < trace.size() ? "," : "");
+		// flush periodically to keep the temporary small
+		if (json.size() > 65536) {
+			out.Write(json.c_str(), json.size());
+			json.clear();
+		}
+	}
+	json += "],\"displayTimeUnit\":\"ms\"}\n";
+	out.Write(json.c_str(), json.size());
+
+	Log(MESSAGE, "Profiler", "Wrote {} trace events to {}.", trace.size(), filename);
+	return true;
+}
+
+}
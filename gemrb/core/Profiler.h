@@ -0,0 +1,126 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2022 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+/**
+ * @file Profiler.h
+ * Scoped timers for the main subsystems, with per-frame histograms
+ * and a chrome://tracing compatible dump.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "exports.h"
+
+#include "Region.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace GemRB {
+
+enum class ProfileZone : uint8_t {
+	GameScripts,
+	MapScripts,
+	Fog,
+	Pathfinding,
+	GameScript,
+	Effects,
+	DrawMap,
+	Tiles,
+	Windows,
+	count
+};
+
+class GEM_EXPORT Profiler {
+public:
+	using usec_t = uint64_t;
+	static constexpr size_t HistoryFrames = 64;
+
+private:
+	struct TraceEvent {
+		usec_t start;
+		usec_t duration;
+		ProfileZone zone;
+	};
+
+	// time spent per zone in each of the last HistoryFrames frames
+	using ZoneHistory = std::array<usec_t, HistoryFrames>;
+	static std::array<ZoneHistory, size_t(ProfileZone::count)> history;
+	static size_t frame;
+	// a ring buffer once full, traceHead is then the oldest event
+	static std::vector<TraceEvent> trace;
+	static size_t traceHead;
+
+	static bool enabled;
+
+public:
+	static bool IsEnabled() { return enabled; }
+	static void Enable(bool enable);
+
+	static usec_t Now()
+	{
+		using namespace std::chrono;
+		return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	static void Record(ProfileZone zone, usec_t start, usec_t end);
+	/** Closes the histogram bucket of the current frame */
+	static void NextFrame();
+	/** Draws the histograms of the last frames as a debug overlay */
+	static void Draw(const Region& rgn);
+	/** Writes the most recent events in the chrome trace event format */
+	static bool DumpTrace(const char* filename);
+
+	static const char* ZoneName(ProfileZone zone);
+};
+
+// measures the time until it goes out of scope; does nothing while the profiler is off
+class ProfileScope {
+	ProfileZone zone;
+	Profiler::usec_t start = 0;
+
+public:
+	explicit ProfileScope(ProfileZone zone)
+	: zone(zone)
+	{
+		if (Profiler::IsEnabled()) {
+			start = Profiler::Now();
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+	~ProfileScope()
+	{
+		if (start && Profiler::IsEnabled()) {
+			Profiler::Record(zone, start, Profiler::Now());
+		}
+	}
+};
+
+#define PROFILE_SCOPE(zone) ProfileScope profileScope_(ProfileZone::zone)
+
+}
+
+#endif
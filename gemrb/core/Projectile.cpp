@@ -1140,7 +1140,7 @@ void Projectile::SecondaryTarget()
 	}
 
 	int radius = Extension->ExplosionRadius / 16;
-	std::vector<Actor *> actors = area->GetAllActorsInRadius(Pos, CalculateTargetFlag(), radius);
+	FrameVector<Actor*> actors = area->GetAllActorsInRadius(Pos, CalculateTargetFlag(), radius);
 	for (const Actor *actor : actors) {
 		ieDword targetID = actor->GetGlobalID();
 
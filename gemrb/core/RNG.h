@@ -46,6 +46,9 @@ class GEM_EXPORT RNG {
 	std::mt19937_64 engine;
 	public:
 	static RNG& getInstance();
+
+	/** Reseeds the generator of the calling thread, for reproducible runs */
+	void Seed(uint32_t seed) noexcept;
 	
 	/**
 	 * It is possible to generate random numbers from [-min, +/-max].
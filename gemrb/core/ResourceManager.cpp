@@ -24,9 +24,33 @@
 #include "PluginMgr.h"
 #include "Resource.h"
 #include "ResourceDesc.h"
+#include "Streams/FileStream.h"
+#if defined(SUPPORTS_MEMSTREAM)
+#include "Streams/MappedFileMemoryStream.h"
+#endif
 
 namespace GemRB {
 
+// the index snapshot starts with the signature and version, followed by the
+// stamps of all sources and the lookups
+static const char IndexSignature[8] = { 'G', 'E', 'M', 'R', 'B', 'I', 'D', 'X' };
+static constexpr ieDword IndexVersion = 1;
+
+std::vector<ResourceManager*> ResourceManager::managers;
+std::mutex ResourceManager::managersMutex;
+
+ResourceManager::ResourceManager() noexcept
+{
+	std::lock_guard<std::mutex> lock(managersMutex);
+	managers.push_back(this);
+}
+
+ResourceManager::~ResourceManager() noexcept
+{
+	std::lock_guard<std::mutex> lock(managersMutex);
+	managers.erase(std::find(managers.begin(), managers.end(), this));
+}
+
 bool ResourceManager::AddSource(const char *path, const char *description, PluginID type, int flags)
 {
 	PluginHolder<ResourceSource> source = MakePluginHolder<ResourceSource>(type);
@@ -35,15 +59,188 @@ bool ResourceManager::AddSource(const char *path, const char *description, Plugi
 		return false;
 	}
 
+	SourceOrigin origin { path, (flags & RM_VOLATILE_SOURCE) != 0 };
 	if (flags & RM_REPLACE_SAME_SOURCE) {
-		for (auto& path2 : searchPath) {
-			if (description == path2->GetDescription()) {
-				path2 = source;
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (description == searchPath[i]->GetDescription()) {
+				searchPath[i] = source;
+				origins[i] = origin;
 				break;
 			}
 		}
 	} else {
 		searchPath.push_back(source);
+		origins.push_back(origin);
+	}
+	ClearIndex();
+	return true;
+}
+
+void ResourceManager::Refresh()
+{
+	for (const auto& source : searchPath) {
+		source->Refresh();
+	}
+	ClearIndex();
+}
+
+void ResourceManager::FileChanged(const char* path)
+{
+	char filename[_MAX_PATH];
+	ExtractFileFromPath(filename, path);
+	std::string key = filename;
+	StringToLower(key);
+
+	std::lock_guard<std::mutex> lock(managersMutex);
+	for (const ResourceManager* manager : managers) {
+		std::lock_guard<std::mutex> indexLock(manager->indexMutex);
+		manager->index.erase(key);
+	}
+}
+
+void ResourceManager::ClearIndex()
+{
+	std::lock_guard<std::mutex> lock(indexMutex);
+	index.clear();
+}
+
+// every source is probed only the first time a resource is looked up, later
+// lookups (including misses) are a single hash probe until the file changes
+template <typename TYPE>
+int ResourceManager::FindSource(StringView ResRef, const TYPE& type, const char* ext) const
+{
+	std::string key = fmt::format("{}.{}", ResRef, ext);
+	StringToLower(key);
+
+	std::lock_guard<std::mutex> lock(indexMutex);
+	const auto& it = index.find(key);
+	if (it != index.end()) {
+		return it->second;
+	}
+
+	int found = -1;
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		if (searchPath[i]->HasResource(ResRef, type)) {
+			found = int(i);
+			break;
+		}
+	}
+	index.emplace(std::move(key), found);
+	return found;
+}
+
+// the snapshot is only valid while the sources have the same size and modification time
+// for directories the latter changes whenever files are added or removed
+std::string ResourceManager::SourceStamp(size_t source) const
+{
+	const SourceOrigin& origin = origins[source];
+	struct stat buf {};
+	if (origin.isVolatile || stat(origin.path.c_str(), &buf) < 0) {
+		return fmt::format("{}:{}", searchPath[source]->GetDescription(), origin.path);
+	}
+	return fmt::format("{}:{}:{}:{}", searchPath[source]->GetDescription(), origin.path,
+					   static_cast<int64_t>(buf.st_size), static_cast<int64_t>(buf.st_mtime));
+}
+
+bool ResourceManager::LoadIndex(const char* path)
+{
+#if defined(SUPPORTS_MEMSTREAM)
+	MappedFileMemoryStream mapped(path);
+	DataStream* str = mapped.isOk() ? &mapped : nullptr;
+#else
+	std::unique_ptr<DataStream> file(FileStream::OpenFile(path));
+	DataStream* str = file.get();
+#endif
+	if (!str) {
+		return false;
+	}
+
+	auto ReadString = [str](std::string& dest, strpos_t len) {
+		dest.resize(len);
+		return len == 0 || str->Read(&dest[0], len) == strret_t(len);
+	};
+
+	char signature[sizeof(IndexSignature)];
+	ieDword version = 0;
+	ieDword sourceCount = 0;
+	str->Read(signature, sizeof(signature));
+	str->ReadDword(version);
+	str->ReadDword(sourceCount);
+	if (memcmp(signature, IndexSignature, sizeof(signature)) != 0 || version != IndexVersion || sourceCount != searchPath.size()) {
+		Log(MESSAGE, "ResourceManager", "Resource index snapshot is outdated, rebuilding.");
+		return false;
+	}
+
+	std::string stamp;
+	for (size_t i = 0; i < sourceCount; ++i) {
+		ieWord len = 0;
+		str->ReadWord(len);
+		if (!ReadString(stamp, len) || stamp != SourceStamp(i)) {
+			Log(MESSAGE, "ResourceManager", "'{}' changed, rebuilding the resource index.", searchPath[i]->GetDescription());
+			return false;
+		}
+	}
+
+	ieDword entryCount = 0;
+	str->ReadDword(entryCount);
+	std::unordered_map<std::string, int> loaded;
+	loaded.reserve(entryCount);
+	std::string key;
+	for (ieDword i = 0; i < entryCount; ++i) {
+		ieByte len = 0;
+		ieDword source = 0;
+		str->Read(&len, 1);
+		if (!ReadString(key, len) || str->ReadDword(source) != sizeof(source)) {
+			Log(WARNING, "ResourceManager", "Resource index snapshot is truncated, ignoring it.");
+			return false;
+		}
+		int found = static_cast<int>(source);
+		if (found >= int(sourceCount)) {
+			return false;
+		}
+		loaded.emplace(key, found);
+	}
+
+	std::lock_guard<std::mutex> lock(indexMutex);
+	index = std::move(loaded);
+	Log(MESSAGE, "ResourceManager", "Loaded {} resource lookups from the index snapshot.", index.size());
+	return true;
+}
+
+bool ResourceManager::SaveIndex(const char* path) const
+{
+	FileStream str;
+	if (!str.Create(path)) {
+		Log(WARNING, "ResourceManager", "Couldn't write the resource index to {}.", path);
+		return false;
+	}
+
+	str.Write(IndexSignature, sizeof(IndexSignature));
+	str.WriteDword(IndexVersion);
+	str.WriteScalar<size_t, ieDword>(searchPath.size());
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		const std::string& stamp = SourceStamp(i);
+		str.WriteScalar<size_t, ieWord>(stamp.length());
+		str.Write(stamp.c_str(), stamp.length());
+	}
+
+	// lookups that ended in a volatile source are left out, its files may be gone by then
+	auto Persistent = [this](const std::pair<const std::string, int>& entry) {
+		return entry.first.length() <= 0xff && (entry.second < 0 || !origins[entry.second].isVolatile);
+	};
+
+	std::lock_guard<std::mutex> lock(indexMutex);
+	ieDword entryCount = 0;
+	for (const auto& entry : index) {
+		if (Persistent(entry)) ++entryCount;
+	}
+	str.WriteDword(entryCount);
+	for (const auto& entry : index) {
+		if (!Persistent(entry)) continue;
+		ieByte len = static_cast<ieByte>(entry.first.length());
+		str.Write(&len, 1);
+		str.Write(entry.first.c_str(), len);
+		str.WriteScalar<int, ieDword>(entry.second);
 	}
 	return true;
 }
@@ -60,11 +257,8 @@ bool ResourceManager::Exists(StringView ResRef, SClass_ID type, bool silent) con
 {
 	if (ResRef.empty())
 		return false;
-	// TODO: check various caches
-	for (const auto& path : searchPath) {
-		if (path->HasResource(ResRef, type)) {
-			return true;
-		}
+	if (FindSource(ResRef, type, core->TypeExt(type)) >= 0) {
+		return true;
 	}
 	if (!silent) {
 		Log(WARNING, "ResourceManager", "'{}.{}' not found...",
@@ -77,13 +271,10 @@ bool ResourceManager::Exists(StringView ResRef, const TypeID *type, bool silent)
 {
 	if (ResRef[0] == '\0')
 		return false;
-	// TODO: check various caches
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (const auto& type2 : types) {
-		for (const auto& path : searchPath) {
-			if (path->HasResource(ResRef, type2)) {
-				return true;
-			}
+		if (FindSource(ResRef, type2, type2.GetExt()) >= 0) {
+			return true;
 		}
 	}
 	if (!silent) {
@@ -98,7 +289,10 @@ DataStream* ResourceManager::GetResource(StringView ResRef, SClass_ID type, bool
 {
 	if (ResRef.empty())
 		return nullptr;
-	for (const auto& path : searchPath) {
+	// sources before the indexed one don't have it; if that one fails we still try the rest
+	int first = FindSource(ResRef, type, core->TypeExt(type));
+	for (size_t i = first; first >= 0 && i < searchPath.size(); ++i) {
+		const auto& path = searchPath[i];
 		DataStream *ds = path->GetResource(ResRef, type);
 		if (ds) {
 			if (!silent) {
@@ -122,7 +316,18 @@ Resource* ResourceManager::GetResource(StringView ResRef, const TypeID *type, bo
 	}
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (const auto& type2 : types) {
-		for (const auto& path : searchPath) {
+		int first = FindSource(ResRef, type2, type2.GetExt());
+		if (first < 0) {
+			if (useCorrupt && core->UseCorruptedHack) {
+				core->UseCorruptedHack = false;
+				return NULL;
+			}
+			core->UseCorruptedHack = false;
+			continue;
+		}
+
+		for (size_t i = first; i < searchPath.size(); ++i) {
+			const auto& path = searchPath[i];
 			DataStream *str = path->GetResource(ResRef, type2);
 			if (!str && useCorrupt && core->UseCorruptedHack) {
 				// don't look at other paths if requested
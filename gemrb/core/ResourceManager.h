@@ -27,17 +27,27 @@
 #include "Resource.h"
 #include "ResourceSource.h"
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
 
 #define RM_REPLACE_SAME_SOURCE 1
+// the contents change while running (the cache), so its timestamp can't validate the index snapshot
+#define RM_VOLATILE_SOURCE 2
 
 class ResourceSource;
 class TypeID;
 
 class GEM_EXPORT ResourceManager {
 public:
+	ResourceManager() noexcept;
+	ResourceManager(const ResourceManager&) = delete;
+	~ResourceManager() noexcept;
+	ResourceManager& operator=(const ResourceManager&) = delete;
+
 	/**
 	 * Add ResourceSource to search path
 	 * @param[in] path Path to be used for source.
@@ -57,8 +67,38 @@ public:
 	/** Returns Resource object associated to given resource */
 	Resource* GetResource(StringView resname, const TypeID *type, bool silent = false, bool useCorrupt = false) const;
 
+	/** Rescans the sources that cache their contents (eg. the override) and forgets all lookups */
+	void Refresh();
+	/** Called when a file is created or removed, so lookups of it are redone */
+	static void FileChanged(const char* path);
+
+	/** Loads an index snapshot written by SaveIndex, if the sources didn't change since */
+	bool LoadIndex(const char* path);
+	/** Writes the index, so the next start doesn't have to probe the sources again */
+	bool SaveIndex(const char* path) const;
+
 private:
 	std::vector<std::shared_ptr<ResourceSource> > searchPath;
+
+	// what the index snapshot is validated against, parallel to searchPath
+	struct SourceOrigin {
+		std::string path;
+		bool isVolatile;
+	};
+	std::vector<SourceOrigin> origins;
+
+	// maps "resref.ext" to the first source in searchPath that has it or -1 if none does
+	mutable std::unordered_map<std::string, int> index;
+	mutable std::mutex indexMutex;
+
+	// all live managers, so FileChanged can reach their indices
+	static std::vector<ResourceManager*> managers;
+	static std::mutex managersMutex;
+
+	template <typename TYPE>
+	int FindSource(StringView resRef, const TYPE& type, const char* ext) const;
+	void ClearIndex();
+	std::string SourceStamp(size_t source) const;
 };
 
 }
@@ -39,6 +39,8 @@ public:
 	virtual bool HasResource(StringView resname, const ResourceDesc &type) = 0;
 	virtual DataStream* GetResource(StringView resname, SClass_ID type) = 0;
 	virtual DataStream* GetResource(StringView resname, const ResourceDesc &type) = 0;
+	/** rescans the contents, only needed for sources that cache them */
+	virtual void Refresh() {}
 	const std::string& GetDescription() const { return description; }
 protected:
 	std::string description;
@@ -546,7 +546,7 @@ static int CanSave()
 	}
 
 	Point pc1 =  game->GetPC(0, true)->Pos;
-	std::vector<Actor *> nearActors = map->GetAllActorsInRadius(pc1, GA_NO_DEAD|GA_NO_UNSCHEDULED, 15);
+	FrameVector<Actor*> nearActors = map->GetAllActorsInRadius(pc1, GA_NO_DEAD|GA_NO_UNSCHEDULED, 15);
 	for (const auto& neighbour : nearActors) {
 		if (neighbour->GetInternalFlag() & IF_NOINT) {
 			// dialog about to start or similar
@@ -3268,7 +3268,7 @@ bool Actor::GetSavingThrow(ieDword type, int modifier, const Effect *fx)
 		// aura of courage
 		if (Modified[IE_EA] < EA_GOODCUTOFF && fx->SourceRef != "SPWI420" && area) {
 			// look if an ally paladin of at least level 2 is near
-			std::vector<Actor *> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_LOS|GA_NO_DEAD|GA_NO_UNSCHEDULED|GA_NO_ENEMY|GA_NO_NEUTRAL|GA_NO_SELF, 10);
+			FrameVector<Actor*> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_LOS|GA_NO_DEAD|GA_NO_UNSCHEDULED|GA_NO_ENEMY|GA_NO_NEUTRAL|GA_NO_SELF, 10);
 			for (const Actor *ally : neighbours) {
 				if (ally->GetPaladinLevel() >= 2 && !ally->CheckSilenced()) {
 					ret += 4;
@@ -4448,6 +4448,9 @@ void Actor::DisplayCombatFeedback(unsigned int damage, int resisted, int damaget
 
 void Actor::PlayWalkSound()
 {
+	// don't waste rolls on sounds nobody hears, so headless runs stay reproducible
+	if (!core->GetAudioDrv()->CanPlay()) return;
+
 	tick_t thisTime = GetMilliseconds();
 	if (thisTime<nextWalk) return;
 	int cnt = anims->GetWalkSoundCount();
@@ -5099,7 +5102,7 @@ static bool OfType(const Actor *a, const Actor *b)
 void Actor::SendDiedTrigger() const
 {
 	if (!area) return;
-	std::vector<Actor *> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_LOS|GA_NO_DEAD|GA_NO_UNSCHEDULED, GetSafeStat(IE_VISUALRANGE));
+	FrameVector<Actor*> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_LOS|GA_NO_DEAD|GA_NO_UNSCHEDULED, GetSafeStat(IE_VISUALRANGE));
 	int ea = Modified[IE_EA];
 
 	for (auto& neighbour : neighbours) {
@@ -7482,7 +7485,7 @@ void Actor::ApplyModal(const ResRef& modalSpell)
 		// target actors around us manually
 		// used for iwd2 songs, as the spells don't use an aoe projectile
 		if (!area) return;
-		std::vector<Actor *> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_LOS|GA_NO_DEAD|GA_NO_UNSCHEDULED, GetSafeStat(IE_VISUALRANGE)/2);
+		FrameVector<Actor*> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_LOS|GA_NO_DEAD|GA_NO_UNSCHEDULED, GetSafeStat(IE_VISUALRANGE)/2);
 		for (const auto& neighbour : neighbours) {
 			core->ApplySpell(modalSpell, neighbour, this, 0);
 		}
@@ -10430,7 +10433,7 @@ bool Actor::SeeAnyOne(bool enemy, bool seenby) const
 		}
 	}
 
-	std::vector<Actor *> visActors = area->GetAllActorsInRadius(Pos, flag, seenby ? VOODOO_VISUAL_RANGE / 2 : GetSafeStat(IE_VISUALRANGE) / 2, this);
+	FrameVector<Actor*> visActors = area->GetAllActorsInRadius(Pos, flag, seenby ? VOODOO_VISUAL_RANGE / 2 : GetSafeStat(IE_VISUALRANGE) / 2, this);
 	bool seeEnemy = false;
 
 	//we need to look harder if we look for seenby anyone
@@ -10520,7 +10523,7 @@ bool Actor::TryToHideIWD2()
 	} else if (ea <= EA_GOODCUTOFF) {
 		flags |= GA_NO_ALLY;
 	}
-	std::vector<Actor *> neighbours = area->GetAllActorsInRadius(Pos, flags, Modified[IE_VISUALRANGE] / 2, this);
+	FrameVector<Actor*> neighbours = area->GetAllActorsInRadius(Pos, flags, Modified[IE_VISUALRANGE] / 2, this);
 	ieDword roll = LuckyRoll(1, 20, GetArmorSkillPenalty(0));
 	int targetDC = 0;
 
@@ -10911,7 +10914,7 @@ bool Actor::ConcentrationCheck() const
 	if (Modified[IE_SPECFLAGS]&SPECF_DRIVEN) return true;
 
 	// anyone in a 5' radius?
-	std::vector<Actor *> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_DEAD|GA_NO_NEUTRAL|GA_NO_ALLY|GA_NO_SELF|GA_NO_UNSCHEDULED|GA_NO_HIDDEN, 5, this);
+	FrameVector<Actor*> neighbours = area->GetAllActorsInRadius(Pos, GA_NO_DEAD|GA_NO_NEUTRAL|GA_NO_ALLY|GA_NO_SELF|GA_NO_UNSCHEDULED|GA_NO_HIDDEN, 5, this);
 	if (neighbours.empty()) return true;
 
 	// so there is someone out to get us and we should do the real concentration check
@@ -820,6 +820,7 @@ public:
 	void UpdateActorState();
 	/* update internal per frame state and return true if state is suitable for drawing the actor */
 	bool UpdateDrawingState();
+	bool HasDrawingState() const { return !currentStance.anim.empty(); }
 	Region DrawingRegion() const override;
 	int GetElevation() const;
 	bool ShouldDrawReticle() const;
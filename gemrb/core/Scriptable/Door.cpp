@@ -40,15 +40,17 @@ DoorTrigger::DoorTrigger(std::shared_ptr<Gem_Polygon> openTrigger, WallPolygonGr
 openTrigger(std::move(openTrigger)), closedTrigger(std::move(closedTrigger))
 {}
 
-void DoorTrigger::SetState(bool open)
+bool DoorTrigger::SetState(bool open)
 {
 	isOpen = open;
+	bool wallsChanged = false;
 	for (const auto& wp : openWalls) {
-		wp->SetDisabled(!isOpen);
+		wallsChanged |= wp->SetDisabled(!isOpen);
 	}
 	for (const auto& wp : closedWalls) {
-		wp->SetDisabled(isOpen);
+		wallsChanged |= wp->SetDisabled(isOpen);
 	}
+	return wallsChanged;
 }
 
 std::shared_ptr<Gem_Polygon> DoorTrigger::StatePolygon() const
@@ -76,7 +78,9 @@ void Door::ImpedeBlocks(const std::vector<Point> &points, PathMapFlags value) co
 
 void Door::UpdateDoor()
 {
-	doorTrigger.SetState(Flags&DOOR_OPEN);
+	if (doorTrigger.SetState(Flags&DOOR_OPEN)) {
+		area->WallStateChanged();
+	}
 	outline = doorTrigger.StatePolygon();
 
 	if (outline) {
@@ -102,6 +106,7 @@ void Door::UpdateDoor()
 		ImpedeBlocks(open_ib, PathMapFlags::IMPASSABLE);
 		ImpedeBlocks(closed_ib, pmdflags);
 	}
+	area->DoorStateChanged();
 
 	InfoPoint *ip = area->TMap->GetInfoPoint(LinkedInfo);
 	if (ip) {
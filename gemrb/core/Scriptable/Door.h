@@ -60,7 +60,8 @@ public:
 	DoorTrigger(std::shared_ptr<Gem_Polygon> openTrigger, WallPolygonGroup&& openWall,
 				std::shared_ptr<Gem_Polygon> closedTrigger, WallPolygonGroup&& closedWall);
 
-	void SetState(bool open);
+	// returns true if any of the wall polygons changed state
+	bool SetState(bool open);
 
 	std::shared_ptr<Gem_Polygon> StatePolygon() const;
 	std::shared_ptr<Gem_Polygon> StatePolygon(bool open) const;
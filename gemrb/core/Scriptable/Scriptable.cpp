@@ -32,6 +32,7 @@
 #include "Video/Video.h"
 #include "GameScript/GSUtils.h"
 #include "GameScript/Matching.h" // MatchActor
+#include "GameScript/ScriptScheduler.h"
 #include "GUI/GameControl.h"
 #include "GUI/TextSystem/Font.h"
 #include "RNG.h"
@@ -264,8 +265,12 @@ void Scriptable::Update()
 
 void Scriptable::TickScripting()
 {
-	// Stagger script updates.
-	if (Ticks % 16 != globalID % 16) {
+	// Stagger script updates: the first round is spread by the global ID,
+	// later ones follow every RoundTicks, unless the area defers them.
+	if (!NextScriptTick) {
+		NextScriptTick = Ticks + globalID % ScriptScheduler::RoundTicks;
+	}
+	if (Ticks < NextScriptTick) {
 		return;
 	}
 
@@ -276,18 +281,17 @@ void Scriptable::TickScripting()
 
 	// Dead actors only get one chance to run a new script.
 	if ((InternalFlags & (IF_REALLYDIED | IF_JUSTDIED)) == IF_REALLYDIED) {
+		NextScriptTick = Ticks + ScriptScheduler::RoundTicks;
 		return;
 	}
 
-	ScriptTicks++;
-
 	// If no action is running, we've had triggers set recently or we haven't checked recently, do a script update.
 	bool needsUpdate = (!CurrentAction) || (TriggerCountdown > 0) || (IdleTicks > 15);
 
 	// Also do a script update if one was forced..
-	if (InternalFlags & IF_FORCEUPDATE) {
+	bool forced = InternalFlags & IF_FORCEUPDATE;
+	if (forced) {
 		needsUpdate = true;
-		InternalFlags &= ~IF_FORCEUPDATE;
 	}
 	// also force it for on-screen actors
 	Region vp = core->GetGameControl()->Viewport();
@@ -300,6 +304,27 @@ void Scriptable::TickScripting()
 		needsUpdate = false;
 	}
 
+	// the area and global scripts are not part of the budget
+	if (needsUpdate && Type != ST_AREA && Type != ST_GLOBAL) {
+		Map* area = GetCurrentArea();
+		if (area) {
+			using Priority = ScriptScheduler::Priority;
+			Priority priority = Priority::Routine;
+			if (forced || !triggers.empty()) {
+				priority = Priority::Triggered;
+			} else if (Ticks - NextScriptTick >= ScriptScheduler::RoundTicks) {
+				priority = Priority::Overdue;
+			}
+			if (!area->GetScriptScheduler().Admit(priority)) {
+				return; // try again next tick
+			}
+		}
+	}
+
+	ScriptTicks++;
+	NextScriptTick = Ticks + ScriptScheduler::RoundTicks;
+	InternalFlags &= ~IF_FORCEUPDATE;
+
 	if (!needsUpdate) {
 		IdleTicks++;
 		return;
@@ -922,7 +947,7 @@ void Scriptable::DisplaySpellCastMessage(ieDword tgt, const Spell* spl) const
 // NOTE: currently includes the sender
 void Scriptable::SendTriggerToAll(TriggerEntry entry)
 {
-	std::vector<Actor *> nearActors = area->GetAllActorsInRadius(Pos, GA_NO_DEAD|GA_NO_UNSCHEDULED, 15);
+	FrameVector<Actor*> nearActors = area->GetAllActorsInRadius(Pos, GA_NO_DEAD|GA_NO_UNSCHEDULED, 15);
 	for (const auto& neighbour : nearActors) {
 		neighbour->AddTrigger(entry);
 	}
@@ -1181,7 +1206,7 @@ void Scriptable::SpellcraftCheck(const Actor *caster, const ResRef& spellRef)
 	const Spell* spl = gamedata->GetSpell(spellRef);
 	assert(spl); // only a bad surge could make this fail and we want to catch it
 	int AdjustedSpellLevel = spl->SpellLevel + 15;
-	std::vector<Actor *> neighbours = area->GetAllActorsInRadius(caster->Pos, GA_NO_DEAD|GA_NO_ENEMY|GA_NO_SELF|GA_NO_UNSCHEDULED, caster->GetBase(IE_VISUALRANGE), this);
+	FrameVector<Actor*> neighbours = area->GetAllActorsInRadius(caster->Pos, GA_NO_DEAD|GA_NO_ENEMY|GA_NO_SELF|GA_NO_UNSCHEDULED, caster->GetBase(IE_VISUALRANGE), this);
 	for (const auto& detective : neighbours) {
 		// disallow neutrals from helping the party
 		if (detective->GetStat(IE_EA) > EA_CONTROLLABLE) {
@@ -2086,6 +2111,70 @@ void Movable::BumpBack()
 	bumpBackTries = 0;
 }
 
+// everyone that could be in the way of this step's probes, in GetActor order
+std::vector<Actor*> Movable::GetStepObstacles(int reach) const
+{
+	std::vector<Actor*> obstacles;
+	for (Actor* other : area->GetAllActors()) {
+		// the IsOver extent of the other actor
+		int csize = std::max<int>(other->circleSize, 2) - 1;
+		if (std::abs(other->Pos.x - Pos.x) > reach + csize * 16) continue;
+		if (std::abs(other->Pos.y - Pos.y) > reach + csize * 12) continue;
+		if (!other->ValidTarget(GA_NO_DEAD | GA_NO_UNSCHEDULED | GA_NO_SELF, this)) continue;
+		obstacles.push_back(other);
+	}
+	return obstacles;
+}
+
+// probes along the heading, from the farthest point in
+Actor* Movable::GetActorInTheWay(const std::vector<Actor*>& obstacles, double dx, double dy, int lookahead) const
+{
+	for (int r = lookahead; r > 0; r--) {
+		Point nmptCollision(Pos.x + dx * r, Pos.y + dy * r * 0.75);
+		for (Actor* other : obstacles) {
+			if (other->IsOver(nmptCollision)) {
+				return other;
+			}
+		}
+	}
+	return nullptr;
+}
+
+// Velocity obstacle style local avoidance: try headings turned away from the
+// blocker, starting on the side it doesn't occupy, and take the first one that
+// is free of blocking actors and leads over walkable ground
+bool Movable::SteerAround(const std::vector<Actor*>& obstacles, const Actor* blocker, double& dx, double& dy, int lookahead) const
+{
+	auto IsWalkable = [this](const Point& p) {
+		// actor flags don't matter here, the others were checked already
+		PathMapFlags flags = area->tileProps.QuerySearchMap(Map::ConvertCoordToTile(p));
+		return bool(flags & PathMapFlags::PASSABLE) && !(flags & (PathMapFlags::SIDEWALL | PathMapFlags::DOOR));
+	};
+
+	// which side of our heading the blocker is on
+	double cross = dx * (blocker->Pos.y - Pos.y) - dy * (blocker->Pos.x - Pos.x);
+	double side = cross > 0 ? -1.0 : 1.0;
+	static const double angles[] = { M_PI / 6, M_PI / 3 };
+	for (double angle : angles) {
+		for (double sign : { side, -side }) {
+			double c = std::cos(sign * angle);
+			double s = std::sin(sign * angle);
+			double ndx = dx * c - dy * s;
+			double ndy = dx * s + dy * c;
+
+			const Actor* other = GetActorInTheWay(obstacles, ndx, ndy, lookahead);
+			if (other && other->BlocksSearchMap()) continue;
+			if (!IsWalkable(Pos + Point(ndx, ndy))) continue;
+			if (!IsWalkable(Pos + Point(ndx * lookahead, ndy * lookahead * 0.75))) continue;
+
+			dx = ndx;
+			dy = ndy;
+			return true;
+		}
+	}
+	return false;
+}
+
 // Takes care of movement and actor bumping, i.e. gently pushing blocking actors out of the way
 // The movement logic is a proportional regulator: the displacement/movement vector has a
 // fixed radius, based on actor walk speed, and its direction heads towards the next waypoint.
@@ -2121,16 +2210,12 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		double dx = nmptStep.x - Pos.x;
 		double dy = nmptStep.y - Pos.y;
 		Map::NormalizeDeltas(dx, dy, double(gamedata->GetStepTime()) / double(walkScale));
-		Actor *actorInTheWay = nullptr;
 		// We can't use GetActorInRadius because we want to only check directly along the way
 		// and not be blocked by actors who are on the sides
 		int collisionLookaheadRadius = ((circleSize < 3 ? 3 : circleSize) - 1) * 3;
-		for (int r = collisionLookaheadRadius; r > 0 && !actorInTheWay; r--) {
-			double xCollision = Pos.x + dx * r;
-			double yCollision = Pos.y + dy * r * 0.75;
-			Point nmptCollision(xCollision, yCollision);
-			actorInTheWay = area->GetActor(nmptCollision, GA_NO_DEAD|GA_NO_UNSCHEDULED|GA_NO_SELF, this);
-		}
+		int reach = int(std::ceil(std::hypot(dx, dy) * collisionLookaheadRadius));
+		const std::vector<Actor*> obstacles = GetStepObstacles(reach);
+		Actor *actorInTheWay = GetActorInTheWay(obstacles, dx, dy, collisionLookaheadRadius);
 
 		const Actor* actor = Scriptable::As<Actor>(this);
 		bool blocksSearch = BlocksSearchMap();
@@ -2145,12 +2230,17 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 				pathAbandoned = true;
 				return;
 			}
-			if (actor && actor->ValidTarget(GA_CAN_BUMP) && actorInTheWay->ValidTarget(GA_ONLY_BUMPABLE)) {
+			// sidestep if there's room, the next steps head back to the path
+			if (SteerAround(obstacles, actorInTheWay, dx, dy, collisionLookaheadRadius)) {
+				steerSteps++;
+			} else if (actor && actor->ValidTarget(GA_CAN_BUMP) && actorInTheWay->ValidTarget(GA_ONLY_BUMPABLE)) {
 				actorInTheWay->BumpAway();
 			} else {
 				Backoff();
 				return;
 			}
+		} else {
+			steerSteps = 0;
 		}
 		// Stop if there's a door in the way
 		if (blocksSearch && bool(area->GetBlocked(Pos + Point(dx, dy)) & PathMapFlags::SIDEWALL)) {
@@ -2386,6 +2476,7 @@ void Movable::ClearPath(bool resetDestination)
 	}
 	path = nullptr;
 	step = nullptr;
+	steerSteps = 0;
 	//don't call ReleaseCurrentAction
 }
 
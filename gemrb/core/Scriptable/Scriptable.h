@@ -133,6 +133,7 @@ class Sprite2D;
 
 #define MAX_PATH_TRIES 8
 #define MAX_BUMP_BACK_TRIES 16
+#define MAX_STEER_STEPS 12
 #define MAX_RAND_WALK 10
 
 using ScriptableType = enum ScriptableType { ST_ACTOR = 0, ST_PROXIMITY = 1, ST_TRIGGER = 2,
@@ -267,6 +268,8 @@ public:
 	ieDword ScriptTicks = 0;
 	// The number of times since TickScripting() tried to do anything.
 	ieDword IdleTicks = 0;
+	// When the next script round is due (0 until the first one is scheduled).
+	ieDword NextScriptTick = 0;
 	// The number of ticks since the last spellcast
 	ieDword AuraCooldown = 0;
 	// The countdown for forced activation by triggers.
@@ -493,7 +496,12 @@ private: //these seem to be sensitive, so get protection
 	PathListNode* step = nullptr; // actual step
 	unsigned int prevTicks = 0;
 	int bumpBackTries = 0;
+	int steerSteps = 0; // consecutive steps spent steering around others
 	bool pathAbandoned = false;
+
+	std::vector<Actor*> GetStepObstacles(int reach) const;
+	Actor* GetActorInTheWay(const std::vector<Actor*>& obstacles, double dx, double dy, int lookahead) const;
+	bool SteerAround(const std::vector<Actor*>& obstacles, const Actor* blocker, double& dx, double& dy, int lookahead) const;
 protected:
 	ieDword timeStartStep = 0;
 	//the # of previous tries to pick up a new walkpath
@@ -524,6 +532,8 @@ public:
 	ieWord maxWalkDistance = 0; // maximum random walk distance from home
 public:
 	inline void ImpedeBumping() { oldPos = Pos; bumped = false; }
+	// local avoidance couldn't get past the others, time for a new path
+	inline bool IsSteeringStuck() const { return steerSteps > MAX_STEER_STEPS; }
 	void AdjustPosition();
 	void BumpAway();
 	void BumpBack();
@@ -0,0 +1,59 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef BUFFERSTREAM_H
+#define BUFFERSTREAM_H
+
+#include "DataStream.h"
+
+#include "exports.h"
+
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * @class BufferStream
+ * A growable in-memory stream for serializing whole files. Writers can seek
+ * back to patch offsets once they are known, then flush everything to the
+ * destination with a single write.
+ */
+
+class GEM_EXPORT BufferStream : public DataStream
+{
+private:
+	std::vector<char> buffer;
+public:
+	explicit BufferStream(const char* name, strpos_t reserve = 0);
+	DataStream* Clone() const noexcept override;
+
+	strret_t Read(void* dest, strpos_t length) override;
+	const char* ReadSpan(strpos_t length) override;
+	strret_t Write(const void* src, strpos_t length) override;
+	stroff_t Seek(stroff_t pos, strpos_t startpos) override;
+
+	/** Writes the whole buffer to dest, returns the number of bytes written */
+	strret_t WriteTo(DataStream& dest) const;
+	const char* Data() const noexcept { return buffer.data(); }
+};
+
+}
+
+#endif
@@ -85,6 +85,9 @@ public:
 	// if (NeedEndianSwap()) swabs(..., len);
 	virtual strret_t Read(void* dest, strpos_t len) = 0;
 	virtual strret_t Write(const void* src, strpos_t len) = 0;
+	/** Skips len bytes and returns a pointer to them, if the stream
+	 *  can expose its data without copying. Returns nullptr otherwise. */
+	virtual const char* ReadSpan(strpos_t /*len*/) { return nullptr; }
 	
 	template <typename T>
 	strret_t ReadScalar(T& dest) {
@@ -141,6 +144,18 @@ public:
 	
 	strret_t WriteFilling(strpos_t len);
 
+	// back-patches a scalar written earlier (usually an offset or size), then returns to the current position
+	template <typename T>
+	strret_t WriteScalarAt(strpos_t pos, const T& src) {
+		strpos_t current = Pos;
+		if (Seek(pos, GEM_STREAM_START) != 0) {
+			return Error;
+		}
+		strret_t len = WriteScalar(src);
+		Seek(current, GEM_STREAM_START);
+		return len;
+	}
+
 	// NOTE: RTrim doesn't cut it when reading text files, since we may accintally read more than one line
 	// so in those situations rather use ReadLine and then convert to desired string type
 	template <typename STR>
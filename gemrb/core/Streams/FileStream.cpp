@@ -21,6 +21,7 @@
 #include "FileStream.h"
 
 #include "Interface.h"
+#include "ResourceManager.h"
 
 namespace GemRB {
 
@@ -121,6 +122,8 @@ bool FileStream::Create(const char *path)
 	if (!str.OpenNew(originalfile)) {
 		return false;
 	}
+	// the file may shadow a resource or satisfy a lookup that failed before
+	ResourceManager::FileChanged(originalfile);
 	opened = true;
 	created = true;
 	Pos = 0;
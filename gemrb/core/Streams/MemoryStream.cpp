@@ -62,6 +62,18 @@ strret_t MemoryStream::Read(void* dest, strpos_t length)
 	return length;
 }
 
+const char* MemoryStream::ReadSpan(strpos_t length)
+{
+	// encrypted data has to be decoded into a copy
+	if (Encrypted || Pos + length > size) {
+		return nullptr;
+	}
+
+	const char* span = data + Pos;
+	Pos += length;
+	return span;
+}
+
 strret_t MemoryStream::Write(const void* src, strpos_t length)
 {
 	if (Pos+length>size ) {
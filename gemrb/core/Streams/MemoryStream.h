@@ -37,8 +37,11 @@ public:
 	DataStream* Clone() const noexcept override;
 
 	strret_t Read(void* dest, strpos_t length) override;
+	const char* ReadSpan(strpos_t length) override;
 	strret_t Write(const void* src, strpos_t length) override;
 	strret_t Seek(stroff_t pos, strpos_t startpos) override;
+
+	const char* Data() const noexcept { return data; }
 };
 
 }
@@ -0,0 +1,135 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2022 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+/**
+ * @file RecordReader.h
+ * Declares RecordReader, a decoder for fixed size records of IE binary formats.
+ * @author The GemRB Project
+ */
+
+#ifndef RECORDREADER_H
+#define RECORDREADER_H
+
+#include "DataStream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace GemRB {
+
+/**
+ * @class RecordReader
+ * Fetches a whole fixed size record with a single stream call and decodes
+ * its little endian fields from there, instead of doing a virtual Read
+ * (and endian check) for every field. Memory streams hand out their data
+ * directly, other streams are copied into a local buffer.
+ */
+
+template <strpos_t SIZE>
+class RecordReader {
+public:
+	explicit RecordReader(DataStream* str)
+	{
+		record = str->ReadSpan(SIZE);
+		if (!record) {
+			// a truncated last record reads as zeroes past the end, like before
+			strpos_t avail = std::min(SIZE, str->Remains());
+			if (avail == 0 || str->Read(buffer, avail) != strret_t(avail)) {
+				avail = 0;
+			}
+			memset(buffer + avail, 0, SIZE - avail);
+			record = buffer;
+		}
+	}
+
+	RecordReader(const RecordReader&) = delete;
+	RecordReader& operator=(const RecordReader&) = delete;
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value, void>::type
+	Read(T& dest)
+	{
+		using U = typename std::make_unsigned<T>::type;
+		dest = static_cast<T>(Load<U>());
+	}
+
+	// like DataStream::ReadScalar<DST, SRC>, reads a SRC and widens it into dest
+	template <typename SRC, typename DST>
+	void Read(DST& dest)
+	{
+		static_assert(sizeof(DST) >= sizeof(SRC), "This flavor of Read requires DST to be >= SRC.");
+		SRC src;
+		Read(src);
+		dest = src;
+	}
+
+	template <typename ENUM>
+	typename std::enable_if<std::is_enum<ENUM>::value, void>::type
+	Read(ENUM& dest)
+	{
+		typename std::underlying_type<ENUM>::type scalar;
+		Read(scalar);
+		dest = static_cast<ENUM>(scalar);
+	}
+
+	// used through the ReadResRef and ReadVariable macros, like with DataStream
+	template <typename STR>
+	void ReadRTrimString(STR& dest, size_t len)
+	{
+		assert(pos + len <= SIZE);
+		memcpy(dest.begin(), record + pos, len);
+		pos += len;
+		RTrim(dest);
+	}
+
+	void Skip(strpos_t len)
+	{
+		assert(pos + len <= SIZE);
+		pos += len;
+	}
+
+	strpos_t GetPos() const noexcept
+	{
+		return pos;
+	}
+
+private:
+	const char* record = nullptr;
+	char buffer[SIZE];
+	strpos_t pos = 0;
+
+	template <typename U>
+	U Load()
+	{
+		assert(pos + sizeof(U) <= SIZE);
+		const auto* bytes = reinterpret_cast<const unsigned char*>(record + pos);
+		U value = 0;
+		for (size_t i = 0; i < sizeof(U); ++i) {
+			value |= static_cast<U>(bytes[i]) << (8 * i);
+		}
+		pos += sizeof(U);
+		return value;
+	}
+};
+
+}
+
+#endif
@@ -32,6 +32,8 @@
 #include "Resource.h"
 #include "Streams/DataStream.h"
 
+#include <vector>
+
 namespace GemRB {
 
 /**
@@ -74,6 +76,8 @@ public:
 	virtual bool Open(DataStream* stream) = 0;
 	virtual String GetString(ieStrRef strref, STRING_FLAGS flags = STRING_FLAGS::NONE) = 0;
 	virtual StringBlock GetStringBlock(ieStrRef strref, STRING_FLAGS flags = STRING_FLAGS::NONE) = 0;
+	/** decodes the strings ahead of time, so later lookups are cheap */
+	virtual void Prefetch(const std::vector<ieStrRef>& /*strrefs*/) {}
 	virtual ieStrRef UpdateString(ieStrRef strref, const String& text) = 0;
 	virtual bool HasAltTLK() const = 0;
 };
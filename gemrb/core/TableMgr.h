@@ -67,14 +67,43 @@ public:
 		return QueryField(GetRowIndex(row), GetColumnIndex(column));
 	}
 	
+	/** Returns a 2da element converted with strtoul, importers may cache the conversion */
+	virtual unsigned long QueryFieldULong(index_t row, index_t column) const
+	{
+		return strtounsigned<unsigned long>(QueryField(row, column).c_str());
+	}
+
+	/** Returns a 2da element converted with strtol, importers may cache the conversion */
+	virtual long QueryFieldLong(index_t row, index_t column) const
+	{
+		return strtosigned<long>(QueryField(row, column).c_str());
+	}
+
 	template <typename RET_T, typename ROW_T, typename COL_T>
 	RET_T QueryFieldUnsigned(const ROW_T& row, const COL_T& column) const {
-		return strtounsigned<RET_T>(QueryField(row, column).c_str());
+		static_assert(std::is_integral<RET_T>::value && std::is_unsigned<RET_T>::value, "Type must be unsigned integral.");
+		static_assert(sizeof(RET_T) <= sizeof(long), "Type is too big for conversion.");
+
+		unsigned long ret = QueryFieldULong(ToIndex(row, &TableMgr::GetRowIndex), ToIndex(column, &TableMgr::GetColumnIndex));
+		if (ret > std::numeric_limits<RET_T>::max()) {
+			return std::numeric_limits<RET_T>::max();
+		}
+		return static_cast<RET_T>(ret);
 	}
 	
 	template <typename RET_T, typename ROW_T, typename COL_T>
 	RET_T QueryFieldSigned(const ROW_T& row, const COL_T& column) const {
-		return strtosigned<RET_T>(QueryField(row, column).c_str());
+		static_assert(std::is_integral<RET_T>::value && std::is_signed<RET_T>::value, "Type must be signed integral.");
+		static_assert(sizeof(RET_T) <= sizeof(long), "Type is too big for conversion.");
+
+		long ret = QueryFieldLong(ToIndex(row, &TableMgr::GetRowIndex), ToIndex(column, &TableMgr::GetColumnIndex));
+		if (ret > std::numeric_limits<RET_T>::max()) {
+			return std::numeric_limits<RET_T>::max();
+		}
+		if (ret < std::numeric_limits<RET_T>::min()) {
+			return std::numeric_limits<RET_T>::min();
+		}
+		return static_cast<RET_T>(ret);
 	}
 	
 	template <typename ROW_T, typename COL_T>
@@ -96,6 +125,19 @@ public:
 
 	/** Opens a Table File */
 	virtual bool Open(DataStream* stream) = 0;
+
+private:
+	using lookup_t = index_t (TableMgr::*)(const key_t&) const;
+
+	static index_t ToIndex(index_t index, lookup_t) noexcept
+	{
+		return index;
+	}
+
+	index_t ToIndex(const key_t& key, lookup_t lookup) const
+	{
+		return (this->*lookup)(key);
+	}
 };
 
 using AutoTable = std::shared_ptr<TableMgr>;
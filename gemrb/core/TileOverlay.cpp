@@ -23,6 +23,7 @@
 #include "Game.h" // for GetGlobalTint
 #include "GlobalTimer.h"
 #include "Interface.h"
+#include "Profiler.h"
 
 namespace GemRB {
 
@@ -37,6 +38,7 @@ void TileOverlay::AddTile(Tile&& tile)
 
 void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr> &overlays, BlitFlags flags) const
 {
+	PROFILE_SCOPE(Tiles);
 	// determine which tiles are visible
 	int sx = std::max(viewport.x / 64, 0);
 	int sy = std::max(viewport.y / 64, 0);
@@ -163,6 +163,12 @@ void Video::SetScreenClip(const Region* clip)
 	}
 }
 
+void Video::ClipToDrawingBuffer()
+{
+	assert(drawingBuffer);
+	screenClip = Region(Point(), drawingBuffer->Size());
+}
+
 bool Video::ToggleFullscreenMode()
 {
 	return SetFullscreenMode(!fullscreen);
@@ -207,6 +213,14 @@ void Video::BlitSprite(const Holder<Sprite2D>& spr, Point p, const Region* clip,
 	BlitSprite(spr, src, fClip, flags | BlitFlags::BLENDED);
 }
 
+void Video::BlitSprites(const Holder<Sprite2D>& spr, const std::vector<SpriteBlit>& blits,
+						BlitFlags flags, Color tint)
+{
+	for (const SpriteBlit& blit : blits) {
+		BlitSprite(spr, blit.src, blit.dst, flags, tint);
+	}
+}
+
 void Video::BlitGameSpriteWithPalette(const Holder<Sprite2D>& spr, const PaletteHolder& pal, const Point& p,
 									  BlitFlags flags, Color tint)
 {
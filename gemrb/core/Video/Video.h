@@ -37,6 +37,7 @@
 
 #include <deque>
 #include <algorithm>
+#include <vector>
 
 namespace GemRB {
 
@@ -68,6 +69,12 @@ public:
 
 using VideoBufferPtr = std::shared_ptr<VideoBuffer>;
 
+// one part of a sprite and where to draw it
+struct SpriteBlit {
+	Region src;
+	Region dst;
+};
+
 /**
  * @class Video
  * Base class for video output plugins.
@@ -168,6 +175,11 @@ public:
 	virtual void BlitSprite(const Holder<Sprite2D>& spr, const Region& src, Region dst,
 							BlitFlags flags, Color tint = Color()) = 0;
 
+	// draws many parts of the same sprite with the same flags and tint (glyph runs, tiles)
+	// drivers can override this to prepare the sprite only once
+	virtual void BlitSprites(const Holder<Sprite2D>& spr, const std::vector<SpriteBlit>& blits,
+							 BlitFlags flags, Color tint = Color());
+
 	virtual void BlitGameSprite(const Holder<Sprite2D>& spr, const Point& p,
 								BlitFlags flags, Color tint = Color()) = 0;
 
@@ -200,6 +212,8 @@ public:
 
 	/** Sets Clip Rectangle */
 	void SetScreenClip(const Region* clip);
+	/** Clips to the whole current drawing buffer, even if it is larger than the screen */
+	void ClipToDrawingBuffer();
 	/** Gets Clip Rectangle */
 	const Region& GetScreenClip() const { return screenClip; }
 	virtual void SetGamma(int brightness, int contrast) = 0;
@@ -23,6 +23,8 @@
 #include "Interface.h"
 #include "Streams/FileStream.h"
 
+#include <algorithm>
+
 using namespace GemRB;
 
 static bool StringCompKey(const std::string& str, TableMgr::key_t key)
@@ -30,6 +32,19 @@ static bool StringCompKey(const std::string& str, TableMgr::key_t key)
 	return stricmp(str.c_str(), key.c_str()) == 0;
 }
 
+// keys may come from fixed size buffers, so like stricmp they end at the first null
+static size_t KeyLength(const TableMgr::key_t& key)
+{
+	const char* end = static_cast<const char*>(memchr(key.c_str(), '\0', key.length()));
+	return end ? end - key.c_str() : key.length();
+}
+
+bool p2DAImporter::KeyEqualCI::operator()(const key_t& a, const key_t& b) const
+{
+	size_t len = KeyLength(a);
+	return len == KeyLength(b) && strnicmp(a.c_str(), b.c_str(), len) == 0;
+}
+
 bool p2DAImporter::Open(DataStream* str)
 {
 	if (str == NULL) {
@@ -80,6 +95,26 @@ bool p2DAImporter::Open(DataStream* str)
 
 	delete str;
 	assert(rows.size() < std::numeric_limits<index_t>::max());
+
+	defSigned = strtosigned<long>(defVal.c_str());
+	defUnsigned = strtounsigned<unsigned long>(defVal.c_str());
+
+	// emplace keeps the first of any duplicate names, like the linear search did
+	colIndex.reserve(colNames.size());
+	for (index_t i = 0; i < colNames.size(); ++i) {
+		colIndex.emplace(key_t(colNames[i]), i);
+	}
+	rowIndex.reserve(rowNames.size());
+	for (index_t i = 0; i < rowNames.size(); ++i) {
+		rowIndex.emplace(key_t(rowNames[i]), i);
+	}
+
+	maxColumns = static_cast<index_t>(colNames.size());
+	for (const auto& row : rows) {
+		maxColumns = std::max(maxColumns, static_cast<index_t>(row.size()));
+	}
+	numericColumns.resize(maxColumns);
+	numericOnce.reset(new std::once_flag[maxColumns]);
 	return true;
 }
 
@@ -123,24 +158,61 @@ const std::string& p2DAImporter::QueryDefault() const
 	return defVal;
 }
 
-p2DAImporter::index_t p2DAImporter::GetRowIndex(const key_t& key) const
+const p2DAImporter::NumericColumn* p2DAImporter::GetNumericColumn(index_t column) const
 {
-	for (index_t index = 0; index < rowNames.size(); index++) {
-		if (StringCompKey(rowNames[index], key)) {
-			return index;
+	if (column >= maxColumns) {
+		return nullptr;
+	}
+
+	// tables are shared through the game data cache, so the lazy parse must be done once
+	std::call_once(numericOnce[column], [this, column]() {
+		NumericColumn& cache = numericColumns[column];
+		index_t rowCount = GetRowCount();
+		cache.signedValues.resize(rowCount);
+		cache.unsignedValues.resize(rowCount);
+		for (index_t row = 0; row < rowCount; ++row) {
+			const char* field = QueryField(row, column).c_str();
+			char* end = nullptr;
+			long value = strtosigned<long>(field, &end);
+			cache.signedValues[row] = value;
+			cache.unsignedValues[row] = strtounsigned<unsigned long>(field);
+			if (end != field) {
+				cache.sortedValues.emplace_back(value, row);
+			}
 		}
+		std::sort(cache.sortedValues.begin(), cache.sortedValues.end());
+	});
+	return &numericColumns[column];
+}
+
+unsigned long p2DAImporter::QueryFieldULong(index_t row, index_t column) const
+{
+	const NumericColumn* cache = GetNumericColumn(column);
+	if (!cache || row >= cache->unsignedValues.size()) {
+		return defUnsigned;
 	}
-	return npos;
+	return cache->unsignedValues[row];
 }
 
-p2DAImporter::index_t p2DAImporter::GetColumnIndex(const key_t& key) const
+long p2DAImporter::QueryFieldLong(index_t row, index_t column) const
 {
-	for (index_t index = 0; index < colNames.size(); index++) {
-		if (StringCompKey(colNames[index], key)) {
-			return index;
-		}
+	const NumericColumn* cache = GetNumericColumn(column);
+	if (!cache || row >= cache->signedValues.size()) {
+		return defSigned;
 	}
-	return npos;
+	return cache->signedValues[row];
+}
+
+p2DAImporter::index_t p2DAImporter::GetRowIndex(const key_t& key) const
+{
+	auto it = rowIndex.find(key);
+	return it == rowIndex.end() ? npos : it->second;
+}
+
+p2DAImporter::index_t p2DAImporter::GetColumnIndex(const key_t& key) const
+{
+	auto it = colIndex.find(key);
+	return it == colIndex.end() ? npos : it->second;
 }
 
 const static std::string blank;
@@ -162,14 +234,22 @@ const std::string& p2DAImporter::GetRowName(index_t index) const
 
 p2DAImporter::index_t p2DAImporter::FindTableValue(index_t col, long val, index_t start) const
 {
-	index_t max = GetRowCount();
-	for (index_t row = start; row < max; row++) {
-		const std::string& ret = QueryField( row, col );
+	const NumericColumn* cache = GetNumericColumn(col);
+	if (!cache) {
+		// only the default value lives out there
 		long Value;
-		if (valid_signednumber(ret.c_str(), Value) && (Value == val))
-			return row;
+		if (start < GetRowCount() && valid_signednumber(defVal.c_str(), Value) && Value == val) {
+			return start;
+		}
+		return npos;
 	}
-	return npos;
+
+	const auto& values = cache->sortedValues;
+	auto it = std::lower_bound(values.begin(), values.end(), std::make_pair(val, start));
+	if (it == values.end() || it->first != val) {
+		return npos;
+	}
+	return it->second;
 }
 
 p2DAImporter::index_t p2DAImporter::FindTableValue(index_t col, const key_t& val, index_t start) const
@@ -26,6 +26,9 @@
 #include "globals.h"
 
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
@@ -35,10 +38,35 @@ private:
 	using cell_t = std::string;
 	using row_t = std::vector<cell_t>;
 
+	struct KeyEqualCI {
+		bool operator()(const key_t& a, const key_t& b) const;
+	};
+	using name_index_t = std::unordered_map<key_t, index_t, CstrHashCI<key_t>, KeyEqualCI>;
+
+	// every cell of a column parsed once, the first time the column is queried as a number
+	struct NumericColumn {
+		std::vector<long> signedValues;
+		std::vector<unsigned long> unsignedValues;
+		// (value, row) pairs of the cells that hold a valid number, sorted for FindTableValue
+		std::vector<std::pair<long, index_t>> sortedValues;
+	};
+
 	std::vector<cell_t> colNames;
 	std::vector<cell_t> rowNames;
 	std::vector<row_t> rows;
 	std::string defVal;
+	long defSigned = 0;
+	unsigned long defUnsigned = 0;
+
+	// the keys point into colNames and rowNames, which never change after Open
+	name_index_t colIndex;
+	name_index_t rowIndex;
+
+	index_t maxColumns = 0;
+	mutable std::vector<NumericColumn> numericColumns;
+	mutable std::unique_ptr<std::once_flag[]> numericOnce;
+
+	const NumericColumn* GetNumericColumn(index_t column) const;
 public:
 	p2DAImporter& operator=(const p2DAImporter&) = delete;
 	bool Open(DataStream* stream) override;
@@ -53,6 +81,8 @@ public:
 		if it cannot return a value, it returns the default */
 	const std::string& QueryField(index_t row, index_t column) const override;
 	const std::string& QueryDefault() const override;
+	unsigned long QueryFieldULong(index_t row, index_t column) const override;
+	long QueryFieldLong(index_t row, index_t column) const override;
 
 	index_t GetRowIndex(const key_t& string) const override;
 	index_t GetColumnIndex(const key_t& string) const override;
@@ -1561,123 +1561,30 @@ void AREImporter::ReadEffects(DataStream *ds, EffectQueue *fxqueue, ieDword Effe
 	}
 }
 
-int AREImporter::GetStoredFileSize(Map *map)
+void AREImporter::CountSections(Map *map)
 {
-	int headersize = map->version+0x11c;
-	ActorOffset = headersize;
+	// only the counts are needed up front, the offsets are taken while writing
 
 	//get only saved actors (no familiars or partymembers)
 	//summons?
 	ActorCount = (ieWord) map->GetActorCount(false);
-	headersize += ActorCount * 0x110;
-
-	auto am = GetImporter<ActorMgr>(IE_CRE_CLASS_ID);
-	EmbeddedCreOffset = headersize;
-
-	for (unsigned int i = 0; i < ActorCount; i++) {
-		headersize += am->GetStoredFileSize(map->GetActor(i, false) );
-	}
-
-	InfoPointsOffset = headersize;
-
 	InfoPointsCount = (ieWord) map->TMap->GetInfoPointCount();
-	headersize += InfoPointsCount * 0xc4;
-	SpawnOffset = headersize;
-
 	SpawnCount = map->GetSpawnCount();
-	headersize += SpawnCount * 0xc8;
-	EntrancesOffset = headersize;
-
 	EntrancesCount = (ieDword) map->GetEntranceCount();
-	headersize += EntrancesCount * 0x68;
-	ContainersOffset = headersize;
 
 	//this one removes empty heaps and counts items, should be before
 	//getting ContainersCount
 	ItemsCount = (ieDword) map->ConsolidateContainers();
 	ContainersCount = (ieDword) map->TMap->GetContainerCount();
-	headersize += ContainersCount * 0xc0;
-	ItemsOffset = headersize;
-	headersize += ItemsCount * 0x14;
-	DoorsOffset = headersize;
-
 	DoorsCount = (ieDword) map->TMap->GetDoorCount();
-	headersize += DoorsCount * 0xc8;
-	VerticesOffset = headersize;
-
-	VerticesCount = 0;
-	for (unsigned int i = 0; i < InfoPointsCount; i++) {
-		const InfoPoint *ip = map->TMap->GetInfoPoint(i);
-		if (ip->outline) {
-			VerticesCount+=ip->outline->Count();
-		} else {
-			VerticesCount++;
-		}
-	}
-	for (unsigned int i = 0; i < ContainersCount; i++) {
-		const Container *c = map->TMap->GetContainer(i);
-		if (c->outline)
-			VerticesCount+=c->outline->Count();
-	}
-	for (unsigned int i = 0; i < DoorsCount; i++) {
-		const Door *d = map->TMap->GetDoor(i);
-		auto open = d->OpenTriggerArea();
-		auto closed = d->ClosedTriggerArea();
-		if (open)
-			VerticesCount += open->Count();
-		if (closed)
-			VerticesCount += closed->Count();
-
-		VerticesCount += d->open_ib.size() + d->closed_ib.size();
-	}
-	headersize += VerticesCount * 4;
-	AmbiOffset = headersize;
-
-	headersize += SavedAmbientCount(map) * 0xd4;
-	VariablesOffset = headersize;
-
 	VariablesCount = (ieDword) map->locals->GetCount();
-	headersize += VariablesCount * 0x54;
-	AnimOffset = headersize;
-
 	AnimCount = (ieDword) map->GetAnimationCount();
-	headersize += AnimCount * 0x4c;
-	TileOffset = headersize;
-
 	TileCount = (ieDword) map->TMap->GetTileCount();
-	headersize += TileCount * 0x6c;
-	ExploredBitmapOffset = headersize;
-
 	ExploredBitmapSize = map->ExploredBitmap.Bytes();
-	headersize += ExploredBitmapSize;
-	EffectOffset = headersize;
 
 	proIterator piter;
 	TrapCount = (ieDword) map->GetTrapCount(piter);
-	for (unsigned int i = 0; i < TrapCount; i++) {
-		const Projectile *pro = map->GetNextTrap(piter);
-		if (pro) {
-			const EffectQueue& fxqueue = pro->GetEffects();
-			if (fxqueue) {
-				headersize += fxqueue.GetSavedEffectsCount() * 0x108;
-			}
-		}
-	}
-
-	TrapOffset = headersize;
-	headersize += TrapCount * 0x1c;
-	NoteOffset = headersize;
-
-	int pst = core->HasFeature( GF_AUTOMAP_INI );
 	NoteCount = map->GetMapNoteCount();
-	headersize += NoteCount * (pst?0x214: 0x34);
-	SongHeader = headersize;
-
-	headersize += 0x90;
-	RestHeader = headersize;
-
-	headersize += 0xe4;
-	return headersize;
 }
 
 int AREImporter::PutHeader(DataStream *stream, const Map *map) const
@@ -2070,7 +1977,8 @@ void AREImporter::PutScript(DataStream *stream, const Actor *ac, unsigned int in
 
 int AREImporter::PutActors(DataStream *stream, const Map *map) const
 {
-	ieDword CreatureOffset = EmbeddedCreOffset;
+	// the embedded creature offsets and sizes are patched in once each is written
+	std::vector<strpos_t> creFields(ActorCount);
 
 	auto am = GetImporter<ActorMgr>(IE_CRE_CLASS_ID);
 	for (unsigned int i = 0; i < ActorCount; i++) {
@@ -2102,24 +2010,24 @@ int AREImporter::PutActors(DataStream *stream, const Map *map) const
 		//creature reference is empty because we are embedding it
 		//the original engine used a '*'
 		stream->WriteFilling(8);
-		stream->WriteDword(CreatureOffset);
-		ieDword CreatureSize = am->GetStoredFileSize(ac);
-		stream->WriteDword(CreatureSize);
-		CreatureOffset += CreatureSize;
+		creFields[i] = stream->GetPos();
+		stream->WriteFilling(8); // offset and size
 		PutScript(stream, ac, SCR_AREA);
 		stream->WriteFilling(120);
 	}
 
-	CreatureOffset = EmbeddedCreOffset;
 	for (unsigned int i = 0; i < ActorCount; i++) {
-		assert(stream->GetPos() == CreatureOffset);
 		const Actor *ac = map->GetActor(i, false);
+		ieDword CreatureOffset = ieDword(stream->GetPos());
 
-		//reconstructing offsets again
-		CreatureOffset += am->GetStoredFileSize(ac);
+		// PutActor expects this to set up its own offsets
+		ieDword CreatureSize = am->GetStoredFileSize(ac);
 		am->PutActor( stream, ac);
+		assert(stream->GetPos() == CreatureOffset + CreatureSize);
+
+		stream->WriteScalarAt(creFields[i], CreatureOffset);
+		stream->WriteScalarAt(creFields[i] + 4, CreatureSize);
 	}
-	assert(stream->GetPos() == CreatureOffset);
 
 	return 0;
 }
@@ -2409,7 +2317,7 @@ int AREImporter::PutRestHeader(DataStream *stream, const Map *map) const
 }
 
 /* no saving of tiled objects, are they used anywhere? */
-int AREImporter::PutArea(DataStream *stream, const Map *map) const
+int AREImporter::PutArea(DataStream *stream, Map *map)
 {
 	ieDword VertIndex = 0;
 	int ret;
@@ -2418,76 +2326,95 @@ int AREImporter::PutArea(DataStream *stream, const Map *map) const
 		return -1;
 	}
 
+	// everything is written in a single pass, the header is written
+	// once more at the end, when all the section offsets are known
+	CountSections(map);
+	strpos_t headerPos = stream->GetPos();
 	ret = PutHeader( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	ActorOffset = ieDword(stream->GetPos());
 	ret = PutActors( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	InfoPointsOffset = ieDword(stream->GetPos());
 	ret = PutRegions( stream, map, VertIndex);
 	if (ret) {
 		return ret;
 	}
 
+	SpawnOffset = ieDword(stream->GetPos());
 	ret = PutSpawns( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	EntrancesOffset = ieDword(stream->GetPos());
 	ret = PutEntrances( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	ContainersOffset = ieDword(stream->GetPos());
 	ret = PutContainers( stream, map, VertIndex);
 	if (ret) {
 		return ret;
 	}
 
+	ItemsOffset = ieDword(stream->GetPos());
 	ret = PutItems( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	DoorsOffset = ieDword(stream->GetPos());
 	ret = PutDoors( stream, map, VertIndex);
 	if (ret) {
 		return ret;
 	}
 
+	VerticesOffset = ieDword(stream->GetPos());
 	ret = PutVertices( stream, map);
 	if (ret) {
 		return ret;
 	}
+	VerticesCount = ieWord((stream->GetPos() - VerticesOffset) / 4);
 
+	AmbiOffset = ieDword(stream->GetPos());
 	ret = PutAmbients( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	VariablesOffset = ieDword(stream->GetPos());
 	ret = PutVariables( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	AnimOffset = ieDword(stream->GetPos());
 	ret = PutAnimations( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	TileOffset = ieDword(stream->GetPos());
 	ret = PutTiles( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	ExploredBitmapOffset = ieDword(stream->GetPos());
 	ret = PutExplored( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	EffectOffset = ieDword(stream->GetPos());
 	proIterator iter;
 	ieDword i = map->GetTrapCount(iter);
 	while(i--) {
@@ -2508,16 +2435,19 @@ int AREImporter::PutArea(DataStream *stream, const Map *map) const
 		}
 	}
 
+	TrapOffset = ieDword(stream->GetPos());
 	ret = PutTraps( stream, map);
 	if (ret) {
 		return ret;
 	}
 
+	NoteOffset = ieDword(stream->GetPos());
 	ret = PutMapnotes( stream, map);
 	if (ret) {
 		return ret;
 	}
 	
+	SongHeader = ieDword(stream->GetPos());
 	for (const auto& list : map->SongList) {
 		stream->WriteDword(list);
 	}
@@ -2527,7 +2457,17 @@ int AREImporter::PutArea(DataStream *stream, const Map *map) const
 		return ret;
 	}
 
+	RestHeader = ieDword(stream->GetPos());
 	ret = PutRestHeader( stream, map);
+	if (ret) {
+		return ret;
+	}
+
+	// back-patch the offsets
+	strpos_t endPos = stream->GetPos();
+	stream->Seek(headerPos, GEM_STREAM_START);
+	ret = PutHeader( stream, map);
+	stream->Seek(endPos, GEM_STREAM_START);
 
 	return ret;
 }
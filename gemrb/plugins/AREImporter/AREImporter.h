@@ -39,7 +39,7 @@ private:
 	ieDword AreaFlags = 0;
 	MapEnv AreaType = AT_UNINITIALIZED;
 	ieWord WRain = 0, WSnow = 0, WFog = 0, WLightning = 0, WUnknown = 0;
-	ieDword ActorOffset = 0, EmbeddedCreOffset = 0, AnimOffset = 0, AnimCount = 0;
+	ieDword ActorOffset = 0, AnimOffset = 0, AnimCount = 0;
 	ieDword VerticesOffset = 0;
 	ieDword DoorsCount = 0, DoorsOffset = 0;
 	ieDword ExploredBitmapSize = 0, ExploredBitmapOffset = 0;
@@ -64,10 +64,10 @@ public:
 	bool Import(DataStream* stream) override;
 	bool ChangeMap(Map *map, bool day_or_night) override;
 	Map* GetMap(const ResRef& resRef, bool day_or_night) override;
-	int GetStoredFileSize(Map *map) override;
 	/* stores an area in the Cache (swaps it out) */
-	int PutArea(DataStream *stream, const Map *map) const override;
+	int PutArea(DataStream *stream, Map *map) override;
 private:
+	void CountSections(Map *map);
 	ieWord SavedAmbientCount(const Map*) const;
 	void AdjustPSTFlags(AreaAnimation&) const;
 	void ReadEffects(DataStream *ds, EffectQueue *fx, ieDword EffectsCount) const;
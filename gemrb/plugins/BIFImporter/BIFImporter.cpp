@@ -26,12 +26,168 @@
 #include "Streams/SlicedStream.h"
 #include "Streams/FileCache.h"
 #include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
 #if defined(SUPPORTS_MEMSTREAM)
 #include "Streams/MappedFileMemoryStream.h"
 #endif
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 using namespace GemRB;
 
+// archives may be opened from the startup prewarm workers, and one
+// of them must not see a cache file that is still being decompressed
+static std::mutex cacheMutex;
+// indexed BIFC archives by path, so their block index and cache outlive
+// the importer instances (guarded by cacheMutex)
+static std::map<std::string, std::shared_ptr<BIFCArchive>> bifcArchives;
+
+// inflated blocks kept per archive; they are mostly 8k or less
+#define MAX_CACHED_BLOCKS 32
+
+BIFCArchive::BIFCArchive(DataStream* compressed)
+	: compressed(compressed)
+{}
+
+BIFCArchive::~BIFCArchive() = default;
+
+bool BIFCArchive::Index()
+{
+	compressed->Seek(8, GEM_STREAM_START);
+	ieDword unCompBifSize;
+	if (compressed->ReadDword(unCompBifSize) != 4) {
+		return false;
+	}
+
+	while (size < unCompBifSize) {
+		Block block;
+		if (compressed->ReadDword(block.declen) != 4 || compressed->ReadDword(block.complen) != 4) {
+			return false;
+		}
+		if (!block.declen || block.complen > compressed->Remains()) {
+			return false;
+		}
+		block.offset = size;
+		block.dataOffset = compressed->GetPos();
+		compressed->Seek(block.complen, GEM_CURRENT_POS);
+		size += block.declen;
+		blocks.push_back(block);
+	}
+	return true;
+}
+
+const MemoryStream* BIFCArchive::GetBlock(size_t index)
+{
+	for (auto& cached : cache) {
+		if (cached.index == index) {
+			cached.lastUse = ++useCounter;
+			return cached.data.get();
+		}
+	}
+
+	const Block& block = blocks[index];
+	std::unique_ptr<MemoryStream> data(new MemoryStream(compressed->originalfile, malloc(block.declen), block.declen));
+	PluginHolder<Compressor> comp = MakePluginHolder<Compressor>(PLUGIN_COMPRESSION_ZLIB);
+	compressed->Seek(block.dataOffset, GEM_STREAM_START);
+	if (!comp || comp->Decompress(data.get(), compressed.get(), block.complen) != GEM_OK || data->GetPos() != block.declen) {
+		Log(ERROR, "BIFImporter", "Cannot decompress block {} of {}.", index, compressed->filename);
+		return nullptr;
+	}
+
+	if (cache.size() < MAX_CACHED_BLOCKS) {
+		cache.push_back({ index, std::move(data), ++useCounter });
+		return cache.back().data.get();
+	}
+	auto oldest = std::min_element(cache.begin(), cache.end(), [](const CachedBlock& a, const CachedBlock& b) {
+		return a.lastUse < b.lastUse;
+	});
+	*oldest = { index, std::move(data), ++useCounter };
+	return oldest->data.get();
+}
+
+bool BIFCArchive::Read(strpos_t offset, void* dest, strpos_t length)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = std::upper_bound(blocks.begin(), blocks.end(), offset, [](strpos_t pos, const Block& block) {
+		return pos < block.offset;
+	});
+	size_t index = std::distance(blocks.begin(), it) - 1;
+
+	char* out = static_cast<char*>(dest);
+	while (length) {
+		if (index >= blocks.size()) {
+			return false;
+		}
+		const MemoryStream* data = GetBlock(index);
+		if (!data) {
+			return false;
+		}
+		strpos_t inBlock = offset - blocks[index].offset;
+		strpos_t chunk = std::min<strpos_t>(length, blocks[index].declen - inBlock);
+		memcpy(out, data->Data() + inBlock, chunk);
+		out += chunk;
+		offset += chunk;
+		length -= chunk;
+		++index;
+	}
+	return true;
+}
+
+BIFCStream::BIFCStream(std::shared_ptr<BIFCArchive> archive, const char* path)
+	: archive(std::move(archive))
+{
+	size = this->archive->Size();
+	ExtractFileFromPath(filename, path);
+	strlcpy(originalfile, path, _MAX_PATH);
+}
+
+DataStream* BIFCStream::Clone() const noexcept
+{
+	return new BIFCStream(archive, originalfile);
+}
+
+strret_t BIFCStream::Read(void* dest, strpos_t length)
+{
+	if (Pos + length > size || !archive->Read(Pos, dest, length)) {
+		return Error;
+	}
+	Pos += length;
+	return length;
+}
+
+strret_t BIFCStream::Write(const void* /*src*/, strpos_t /*length*/)
+{
+	error("BIFCStream", "Attempted to write to a compressed archive!");
+}
+
+stroff_t BIFCStream::Seek(stroff_t newpos, strpos_t type)
+{
+	switch (type) {
+		case GEM_CURRENT_POS:
+			Pos += newpos;
+			break;
+
+		case GEM_STREAM_START:
+			Pos = newpos;
+			break;
+
+		case GEM_STREAM_END:
+			Pos = size - newpos;
+			break;
+
+		default:
+			return InvalidPos;
+	}
+	//we went past the buffer
+	if (Pos > size) {
+		Log(ERROR, "Streams", "Invalid seek position: {} (limit: {})", Pos, size);
+		return InvalidPos;
+	}
+	return 0;
+}
+
 BIFImporter::~BIFImporter(void)
 {
 	delete stream;
@@ -79,6 +235,23 @@ DataStream* BIFImporter::DecompressBIFC(DataStream* compressed, const char* path
 #endif
 }
 
+DataStream* BIFImporter::OpenBIFC(DataStream* compressed, const char* path)
+{
+	std::shared_ptr<BIFCArchive>& archive = bifcArchives[path];
+	if (archive) {
+		delete compressed;
+	} else {
+		auto newArchive = std::make_shared<BIFCArchive>(compressed);
+		if (!newArchive->Index()) {
+			Log(ERROR, "BIFImporter", "Damaged compressed archive {}.", path);
+			bifcArchives.erase(path);
+			return nullptr;
+		}
+		archive = std::move(newArchive);
+	}
+	return new BIFCStream(archive, path);
+}
+
 DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const char* /*path*/)
 {
 	ieDword fnlen, complen, declen;
@@ -92,6 +265,7 @@ DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const char* /*pat
 
 int BIFImporter::OpenArchive(const char* path)
 {
+	std::lock_guard<std::mutex> lock(cacheMutex);
 	delete stream;
 	stream = nullptr;
 
@@ -101,6 +275,15 @@ int BIFImporter::OpenArchive(const char* path)
 	char cachePath[_MAX_PATH];
 	PathJoin(cachePath, core->config.CachePath, filename, nullptr);
 	char Signature[8];
+
+	// already indexed, no need to look at the file again
+	auto bifc = bifcArchives.find(path);
+	if (bifc != bifcArchives.end()) {
+		stream = new BIFCStream(bifc->second, path);
+		stream->Read(Signature, 8);
+		return strncmp(Signature, "BIFFV1  ", 8) == 0 ? ReadBIF() : GEM_ERROR;
+	}
+
 #if defined(SUPPORTS_MEMSTREAM)
 	auto cacheStream = new MappedFileMemoryStream{cachePath};
 
@@ -128,8 +311,12 @@ int BIFImporter::OpenArchive(const char* path)
 			stream = DecompressBIF(file, cachePath);
 			delete file;
 		} else if (strncmp(Signature, "BIFCV1.0", 8) == 0) {
-			stream = DecompressBIFC(file, cachePath);
-			delete file;
+			if (core->config.CacheCompressedBIFs) {
+				stream = DecompressBIFC(file, cachePath);
+				delete file;
+			} else {
+				stream = OpenBIFC(file, path);
+			}
 		} else if (strncmp( Signature, "BIFFV1  ", 8 ) == 0) {
 			file->Seek(0, GEM_STREAM_START);
 			stream = file;
@@ -27,8 +27,14 @@
 
 #include "Streams/DataStream.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace GemRB {
 
+class MemoryStream;
+
 struct FileEntry {
 	ieDword resLocator;
 	ieDword dataOffset;
@@ -46,6 +52,62 @@ struct TileEntry {
 	ieWord  u1; //Unknown Field, part of type dword in ee
 };
 
+/**
+ * @class BIFCArchive
+ * Random access to a BIFC archive, which is a sequence of separately
+ * zlib compressed blocks. Only the blocks backing the requested data are
+ * inflated and the most recently used ones are kept in memory.
+ */
+class BIFCArchive {
+private:
+	struct Block {
+		strpos_t offset; // in the uncompressed data
+		strpos_t dataOffset; // of the compressed data in the file
+		ieDword declen;
+		ieDword complen;
+	};
+	struct CachedBlock {
+		size_t index;
+		std::unique_ptr<MemoryStream> data;
+		unsigned long lastUse;
+	};
+
+	std::unique_ptr<DataStream> compressed;
+	std::vector<Block> blocks;
+	strpos_t size = 0;
+
+	// the streams of all archive users share the file and the cache
+	std::mutex mutex;
+	std::vector<CachedBlock> cache;
+	unsigned long useCounter = 0;
+
+	const MemoryStream* GetBlock(size_t index);
+public:
+	explicit BIFCArchive(DataStream* compressed);
+	~BIFCArchive();
+
+	/** Reads the block headers, fails if the archive is damaged */
+	bool Index();
+	strpos_t Size() const { return size; }
+	bool Read(strpos_t offset, void* dest, strpos_t length);
+};
+
+/**
+ * @class BIFCStream
+ * Reads the uncompressed contents of a BIFC archive
+ */
+class BIFCStream : public DataStream {
+private:
+	std::shared_ptr<BIFCArchive> archive;
+public:
+	BIFCStream(std::shared_ptr<BIFCArchive> archive, const char* path);
+	DataStream* Clone() const noexcept override;
+
+	strret_t Read(void* dest, strpos_t length) override;
+	strret_t Write(const void* src, strpos_t length) override;
+	stroff_t Seek(stroff_t pos, strpos_t startpos) override;
+};
+
 class BIFImporter : public IndexedArchive {
 private:
 	FileEntry* fentries = nullptr;
@@ -63,6 +125,7 @@ public:
 private:
 	static DataStream* DecompressBIF(DataStream* compressed, const char* path);
 	static DataStream* DecompressBIFC(DataStream* compressed, const char* path);
+	static DataStream* OpenBIFC(DataStream* compressed, const char* path);
 	int ReadBIF();
 };
 
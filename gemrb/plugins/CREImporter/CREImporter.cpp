@@ -30,6 +30,7 @@
 #include "RNG.h"
 #include "TableMgr.h"
 #include "GameScript/GameScript.h"
+#include "Streams/RecordReader.h"
 
 #include <cassert>
 
@@ -724,21 +725,23 @@ bool CREImporter::SeekCreHeader(char *Signature)
 
 CREMemorizedSpell* CREImporter::GetMemorizedSpell()
 {
+	RecordReader<12> record(str);
 	CREMemorizedSpell* spl = new CREMemorizedSpell();
 
-	str->ReadResRef( spl->SpellResRef );
-	str->ReadDword(spl->Flags); // was split into flags word and two alignment bytes
+	record.ReadResRef(spl->SpellResRef);
+	record.Read(spl->Flags); // was split into flags word and two alignment bytes
 
 	return spl;
 }
 
 CREKnownSpell* CREImporter::GetKnownSpell()
 {
+	RecordReader<12> record(str);
 	CREKnownSpell* spl = new CREKnownSpell();
 
-	str->ReadResRef(spl->SpellResRef);
-	str->ReadWord(spl->Level);
-	str->ReadWord(spl->Type);
+	record.ReadResRef(spl->SpellResRef);
+	record.Read(spl->Level);
+	record.Read(spl->Type);
 
 	return spl;
 }
@@ -752,14 +755,15 @@ void CREImporter::ReadScript(Actor *act, int ScriptLevel)
 
 CRESpellMemorization* CREImporter::GetSpellMemorization(Actor *act)
 {
+	RecordReader<16> record(str);
 	ieWord Level, Type, Number, Number2;
 
-	str->ReadWord(Level);
-	str->ReadWord(Number);
-	str->ReadWord(Number2);
-	str->ReadWord(Type);
-	str->ReadDword(MemorizedIndex);
-	str->ReadDword(MemorizedCount);
+	record.Read(Level);
+	record.Read(Number);
+	record.Read(Number2);
+	record.Read(Type);
+	record.Read(MemorizedIndex);
+	record.Read(MemorizedCount);
 
 	CRESpellMemorization* spl = act->spellbook.GetSpellMemorization(Type, Level);
 	assert(spl && spl->SlotCount == 0 && spl->SlotCountWithBonus == 0); // unused
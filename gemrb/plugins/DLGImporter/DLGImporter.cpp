@@ -22,10 +22,27 @@
 
 #include "Interface.h"
 #include "GameScript/GameScript.h"
+#include "GameScript/GSUtils.h"
 #include "Streams/FileStream.h"
 
+#include <unordered_map>
+
 using namespace GemRB;
 
+struct ReleaseAction {
+	void operator()(Action* action) const
+	{
+		action->Release();
+	}
+};
+using ActionTemplate = std::unique_ptr<Action, ReleaseAction>;
+
+// parsed trigger and action blocks, keyed by their text, so the dialogs that
+// get loaded over and over (banters, rumours, repeated talks) skip the parser;
+// conditions are only read once built, while actions get handed out as copies
+static std::unordered_map<std::string, std::shared_ptr<const Condition>> conditionCache;
+static std::unordered_map<std::string, std::vector<ActionTemplate>> actionCache;
+
 bool DLGImporter::Import(DataStream* str)
 {
 	char Signature[8];
@@ -137,7 +154,7 @@ DialogTransition* DLGImporter::GetTransition(unsigned int index) const
 		dt->condition = GetTransitionTrigger( TriggerIndex );
 	}
 	else {
-		dt->condition = NULL;
+		dt->condition = nullptr;
 	}
 	if (dt->Flags & IE_DLG_TR_ACTION) {
 		dt->actions = GetAction( ActionIndex );
@@ -162,51 +179,60 @@ Condition* DLGImporter::GetCondition(const char* string) const
 		free( lines[i] );
 	}
 	free( lines );
+	condition->PreparePrefilter();
 	return condition;
 }
 
-Condition* DLGImporter::GetStateTrigger(unsigned int index) const
+std::shared_ptr<const Condition> DLGImporter::GetCachedCondition(const std::string& text) const
 {
-	if ((signed)index == -1) index = 0;
-	if (index >= StateTriggersCount) {
-		return NULL;
+	auto it = conditionCache.find(text);
+	if (it == conditionCache.end()) {
+		it = conditionCache.emplace(text, std::shared_ptr<const Condition>(GetCondition(text.c_str()))).first;
 	}
+	return it->second;
+}
+
+// returns the stored length, the text stops at the first nul like the parser does
+ieDword DLGImporter::ReadScript(ieDword tableOffset, unsigned int index, std::string& text) const
+{
 	//8 = sizeof(VarOffset)
-	str->Seek( StateTriggersOffset + ( index * 8 ), GEM_STREAM_START );
+	str->Seek( tableOffset + ( index * 8 ), GEM_STREAM_START );
 	ieDword Offset, Length;
 	str->ReadDword(Offset);
 	str->ReadDword(Length);
+	text.assign(Length, '\0');
+	if (Length) {
+		str->Seek( Offset, GEM_STREAM_START );
+		str->Read( &text[0], Length );
+		text.resize(strlen(text.c_str()));
+	}
+	return Length;
+}
+
+std::shared_ptr<const Condition> DLGImporter::GetStateTrigger(unsigned int index) const
+{
+	if ((signed)index == -1) index = 0;
+	if (index >= StateTriggersCount) {
+		return nullptr;
+	}
+	std::string text;
 	//a zero length trigger counts as no trigger
 	//a // comment counts as true(), so we simply ignore zero
 	//length trigger text like it isn't there
-	if (!Length) {
-		return NULL;
+	if (!ReadScript(StateTriggersOffset, index, text)) {
+		return nullptr;
 	}
-	str->Seek( Offset, GEM_STREAM_START );
-	char* string = ( char* ) malloc( Length + 1 );
-	str->Read( string, Length );
-	string[Length] = 0;
-	Condition *condition = GetCondition(string);
-	free( string );
-	return condition;
+	return GetCachedCondition(text);
 }
 
-Condition* DLGImporter::GetTransitionTrigger(unsigned int index) const
+std::shared_ptr<const Condition> DLGImporter::GetTransitionTrigger(unsigned int index) const
 {
 	if (index >= TransitionTriggersCount) {
-		return NULL;
+		return nullptr;
 	}
-	str->Seek( TransitionTriggersOffset + ( index * 8 ), GEM_STREAM_START );
-	ieDword Offset, Length;
-	str->ReadDword(Offset);
-	str->ReadDword(Length);
-	str->Seek( Offset, GEM_STREAM_START );
-	char* string = ( char* ) malloc( Length + 1 );
-	str->Read( string, Length );
-	string[Length] = 0;
-	Condition *condition = GetCondition(string);
-	free( string );
-	return condition;
+	std::string text;
+	ReadScript(TransitionTriggersOffset, index, text);
+	return GetCachedCondition(text);
 }
 
 std::vector<Action*> DLGImporter::GetAction(unsigned int index) const
@@ -214,29 +240,35 @@ std::vector<Action*> DLGImporter::GetAction(unsigned int index) const
 	if (index >= ActionsCount) {
 		return std::vector<Action*>();
 	}
-	str->Seek( ActionsOffset + ( index * 8 ), GEM_STREAM_START );
-	ieDword Offset, Length;
-	str->ReadDword(Offset);
-	str->ReadDword(Length);
-	str->Seek( Offset, GEM_STREAM_START );
-	char* string = ( char* ) malloc( Length + 1 );
-	str->Read( string, Length );
-	string[Length] = 0;
-	unsigned int count;
-	char ** lines = GetStrings( string, count );
-	std::vector<Action*> actions;
-	for (size_t i = 0; i < count; ++i) {
-		Action *action = GenerateAction(lines[i]);
-		if (!action) {
-			Log(WARNING, "DLGImporter", "Can't compile action: {}", lines[i]);
-		} else {
-			action->IncRef();
-			actions.push_back(action);
+	std::string text;
+	ReadScript(ActionsOffset, index, text);
+	auto it = actionCache.find(text);
+	if (it == actionCache.end()) {
+		unsigned int count;
+		char ** lines = GetStrings( text.c_str(), count );
+		std::vector<ActionTemplate> templates;
+		for (size_t i = 0; i < count; ++i) {
+			Action *action = GenerateAction(lines[i]);
+			if (!action) {
+				Log(WARNING, "DLGImporter", "Can't compile action: {}", lines[i]);
+			} else {
+				action->IncRef();
+				templates.emplace_back(action);
+			}
+			free( lines[i] );
 		}
-		free( lines[i] );
+		free( lines );
+		it = actionCache.emplace(text, std::move(templates)).first;
+	}
+
+	// actions keep state while they run, so every dialog gets its own
+	std::vector<Action*> actions;
+	actions.reserve(it->second.size());
+	for (const auto& action : it->second) {
+		Action *copy = ParamCopy(action.get());
+		copy->IncRef();
+		actions.push_back(copy);
 	}
-	free( lines );
-	free( string );
 	return actions;
 }
 
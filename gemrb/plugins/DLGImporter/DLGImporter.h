@@ -51,8 +51,10 @@ private:
 	bool Import(DataStream* stream) override;
 	DialogState* GetDialogState(Dialog *d, unsigned int index) const;
 	DialogTransition* GetTransition(unsigned int index) const;
-	Condition* GetStateTrigger(unsigned int index) const;
-	Condition* GetTransitionTrigger(unsigned int index) const;
+	ieDword ReadScript(ieDword tableOffset, unsigned int index, std::string& text) const;
+	std::shared_ptr<const Condition> GetCachedCondition(const std::string& text) const;
+	std::shared_ptr<const Condition> GetStateTrigger(unsigned int index) const;
+	std::shared_ptr<const Condition> GetTransitionTrigger(unsigned int index) const;
 	std::vector<Action*> GetAction(unsigned int index) const;
 	DialogTransition** GetTransitions(unsigned int firstIndex,
 		unsigned int count) const;
@@ -48,7 +48,7 @@ protected:
 public:
 	CachedDirectoryImporter() noexcept = default;
 	bool Open(const char *dir, const char *desc) override;
-	void Refresh();
+	void Refresh() override;
 	/** predicts the availability of a resource */
 	bool HasResource(StringView resname, SClass_ID type) override;
 	bool HasResource(StringView resname, const ResourceDesc &type) override;
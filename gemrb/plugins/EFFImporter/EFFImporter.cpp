@@ -21,6 +21,7 @@
 #include "EFFImporter.h"
 
 #include "Interface.h"
+#include "Streams/RecordReader.h"
 
 using namespace GemRB;
 
@@ -79,35 +80,36 @@ Effect* EFFImporter::GetEffect()
 
 Effect* EFFImporter::GetEffectV1()
 {
+	RecordReader<48> record(str);
 	ieByte tmpByte;
 	ieWord tmpWord;
 
 	Effect* fx = new Effect;
 
-	str->ReadWord(tmpWord);
+	record.Read(tmpWord);
 	fx->Opcode = tmpWord;
-	str->Read( &tmpByte, 1 );
+	record.Read(tmpByte);
 	fx->Target = tmpByte;
-	str->Read( &tmpByte, 1 );
+	record.Read(tmpByte);
 	fx->Power = tmpByte;
-	str->ReadDword(fx->Parameter1);
-	str->ReadDword(fx->Parameter2);
-	str->Read( &tmpByte, 1 );
+	record.Read(fx->Parameter1);
+	record.Read(fx->Parameter2);
+	record.Read(tmpByte);
 	fx->TimingMode = tmpByte;
-	str->Read( &tmpByte, 1 );
+	record.Read(tmpByte);
 	fx->Resistance = tmpByte;
-	str->ReadDword(fx->Duration);
-	str->Read( &tmpByte, 1 );
+	record.Read(fx->Duration);
+	record.Read(tmpByte);
 	fx->ProbabilityRangeMax = tmpByte;
-	str->Read( &tmpByte, 1 );
+	record.Read(tmpByte);
 	fx->ProbabilityRangeMin = tmpByte;
-	str->ReadResRef( fx->Resource );
-	str->ReadDword(fx->DiceThrown);
-	str->ReadDword(fx->DiceSides);
-	str->ReadDword(fx->SavingThrowType);
-	str->ReadDword(fx->SavingThrowBonus);
-	str->ReadWord(fx->IsVariable);
-	str->ReadWord(fx->IsSaveForHalfDamage);
+	record.ReadResRef(fx->Resource);
+	record.Read(fx->DiceThrown);
+	record.Read(fx->DiceSides);
+	record.Read(fx->SavingThrowType);
+	record.Read(fx->SavingThrowBonus);
+	record.Read(fx->IsVariable);
+	record.Read(fx->IsSaveForHalfDamage);
 	fixAffectedLevels( fx );
 
 	fx->Pos.Invalidate();
@@ -121,59 +123,60 @@ Effect* EFFImporter::GetEffectV20()
 	Effect* fx = new Effect;
 
 	str->Seek(8, GEM_CURRENT_POS);
-	str->ReadDword(fx->Opcode);
-	str->ReadDword(fx->Target);
-	str->ReadDword(fx->Power);
-	str->ReadDword(fx->Parameter1);
-	str->ReadDword(fx->Parameter2);
-	str->ReadWord(fx->TimingMode);
-	str->ReadWord(fx->unknown2); // part of a dword TimingMode (but only true for v2 effects)
-	str->ReadDword(fx->Duration);
-	str->ReadWord(fx->ProbabilityRangeMax);
-	str->ReadWord(fx->ProbabilityRangeMin);
-	str->ReadResRef( fx->Resource );
-	str->ReadDword(fx->DiceThrown);
-	str->ReadDword(fx->DiceSides);
-	str->ReadDword(fx->SavingThrowType);
-	str->ReadDword(fx->SavingThrowBonus);
-	str->ReadWord(fx->IsVariable); //if this field was set to 1, this is a variable
-	str->ReadWord(fx->IsSaveForHalfDamage); //if this field was set to 1, save for half damage; part of Special dword with the preceding field
-	str->ReadDword(fx->PrimaryType);
-	str->Seek(4, GEM_CURRENT_POS); // JeremyIsAnIdiot in the original :D
-	str->ReadDword(fx->MinAffectedLevel);
-	str->ReadDword(fx->MaxAffectedLevel);
-	str->ReadDword(fx->Resistance);
-	str->ReadDword(fx->Parameter3);
-	str->ReadDword(fx->Parameter4);
-	str->ReadDword(fx->Parameter5);
-	str->ReadDword(fx->Parameter6);
-	str->ReadResRef( fx->Resource2 );
-	str->ReadResRef( fx->Resource3 );
-	str->ReadDword(tmp);
+	RecordReader<256> record(str);
+	record.Read(fx->Opcode);
+	record.Read(fx->Target);
+	record.Read(fx->Power);
+	record.Read(fx->Parameter1);
+	record.Read(fx->Parameter2);
+	record.Read(fx->TimingMode);
+	record.Read(fx->unknown2); // part of a dword TimingMode (but only true for v2 effects)
+	record.Read(fx->Duration);
+	record.Read(fx->ProbabilityRangeMax);
+	record.Read(fx->ProbabilityRangeMin);
+	record.ReadResRef(fx->Resource);
+	record.Read(fx->DiceThrown);
+	record.Read(fx->DiceSides);
+	record.Read(fx->SavingThrowType);
+	record.Read(fx->SavingThrowBonus);
+	record.Read(fx->IsVariable); //if this field was set to 1, this is a variable
+	record.Read(fx->IsSaveForHalfDamage); //if this field was set to 1, save for half damage; part of Special dword with the preceding field
+	record.Read(fx->PrimaryType);
+	record.Skip(4); // JeremyIsAnIdiot in the original :D
+	record.Read(fx->MinAffectedLevel);
+	record.Read(fx->MaxAffectedLevel);
+	record.Read(fx->Resistance);
+	record.Read(fx->Parameter3);
+	record.Read(fx->Parameter4);
+	record.Read(fx->Parameter5);
+	record.Read(fx->Parameter6);
+	record.ReadResRef(fx->Resource2);
+	record.ReadResRef(fx->Resource3);
+	record.Read(tmp);
 	fx->Source.x = tmp;
-	str->ReadDword(tmp);
+	record.Read(tmp);
 	fx->Source.y = tmp;
-	str->ReadDword(tmp);
+	record.Read(tmp);
 	fx->Pos.x = tmp;
-	str->ReadDword(tmp);
+	record.Read(tmp);
 	fx->Pos.y = tmp;
-	str->ReadDword(fx->SourceType);
-	str->ReadResRef(fx->SourceRef);
-	str->ReadDword(fx->SourceFlags);
-	str->ReadDword(fx->Projectile);
-	str->ReadDword(tmp);
+	record.Read(fx->SourceType);
+	record.ReadResRef(fx->SourceRef);
+	record.Read(fx->SourceFlags);
+	record.Read(fx->Projectile);
+	record.Read(tmp);
 	fx->InventorySlot=(ieDwordSigned) (tmp);
 	//Variable simply overwrites the resource fields (Keep them grouped)
 	//They have to be continuous
 	if (fx->IsVariable) {
-		str->ReadVariable(fx->VariableName);
+		record.ReadVariable(fx->VariableName);
 	} else {
-		str->Seek( 32, GEM_CURRENT_POS);
+		record.Skip(32);
 	}
-	str->ReadDword(fx->CasterLevel);
-	str->Seek(4, GEM_CURRENT_POS); // FirstApply
-	str->ReadDword(fx->SecondaryType);
-	str->Seek(60, GEM_CURRENT_POS); // padding
+	record.Read(fx->CasterLevel);
+	record.Skip(4); // FirstApply
+	record.Read(fx->SecondaryType);
+	// the rest is padding
 
 	return fx;
 }
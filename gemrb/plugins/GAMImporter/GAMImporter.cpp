@@ -1044,53 +1044,56 @@ int GAMImporter::PutActor(DataStream* stream, const Actor* ac, ieDword CRESize,
 int GAMImporter::PutPCs(DataStream *stream, const Game *game) const
 {
 	auto am = GetImporter<ActorMgr>(IE_CRE_CLASS_ID);
-	ieDword CREOffset = PCOffset + PCCount * PCSize;
 
+	// the creature offsets and sizes are patched in once each is written
 	for (unsigned int i = 0; i < PCCount; i++) {
 		assert(stream->GetPos() == PCOffset + i * PCSize);
 		const Actor *ac = game->GetPC(i, false);
-		ieDword CRESize = am->GetStoredFileSize(ac);
-		PutActor(stream, ac, CRESize, CREOffset, game->version);
-		CREOffset += CRESize;
+		PutActor(stream, ac, 0, 0, game->version);
 	}
 
-	CREOffset = PCOffset + PCCount * PCSize; // just for the asserts..
-	assert(stream->GetPos() == CREOffset);
-
 	for (unsigned int i = 0; i < PCCount; i++) {
-		assert(stream->GetPos() == CREOffset);
 		const Actor *ac = game->GetPC(i, false);
-		//reconstructing offsets again
-		CREOffset += am->GetStoredFileSize(ac);
+		ieDword CREOffset = ieDword(stream->GetPos());
+
+		// PutActor expects this to set up its own offsets
+		ieDword CRESize = am->GetStoredFileSize(ac);
 		am->PutActor( stream, ac);
+		assert(stream->GetPos() == CREOffset + CRESize);
+
+		// the offset and size follow the two leading words of the record
+		strpos_t record = PCOffset + i * PCSize;
+		stream->WriteScalarAt(record + 4, CREOffset);
+		stream->WriteScalarAt(record + 8, CRESize);
 	}
-	assert(stream->GetPos() == CREOffset);
 	return 0;
 }
 
 int GAMImporter::PutNPCs(DataStream *stream, const Game *game) const
 {
 	auto am = GetImporter<ActorMgr>(IE_CRE_CLASS_ID);
-	ieDword CREOffset = NPCOffset + NPCCount * PCSize;
 
+	// the creature offsets and sizes are patched in once each is written
 	for (unsigned int i = 0; i < NPCCount; i++) {
 		assert(stream->GetPos() == NPCOffset + i * PCSize);
 		const Actor *ac = game->GetNPC(i);
-		ieDword CRESize = am->GetStoredFileSize(ac);
-		PutActor(stream, ac, CRESize, CREOffset, game->version);
-		CREOffset += CRESize;
+		PutActor(stream, ac, 0, 0, game->version);
 	}
-	CREOffset = NPCOffset + NPCCount * PCSize; // just for the asserts..
-	assert(stream->GetPos() == CREOffset);
 
-	for (unsigned int  i = 0; i < NPCCount; i++) {
-		assert(stream->GetPos() == CREOffset);
+	for (unsigned int i = 0; i < NPCCount; i++) {
 		const Actor *ac = game->GetNPC(i);
-		//reconstructing offsets again
-		CREOffset += am->GetStoredFileSize(ac);
+		ieDword CREOffset = ieDword(stream->GetPos());
+
+		// PutActor expects this to set up its own offsets
+		ieDword CRESize = am->GetStoredFileSize(ac);
 		am->PutActor( stream, ac);
+		assert(stream->GetPos() == CREOffset + CRESize);
+
+		// the offset and size follow the two leading words of the record
+		strpos_t record = NPCOffset + i * PCSize;
+		stream->WriteScalarAt(record + 4, CREOffset);
+		stream->WriteScalarAt(record + 8, CRESize);
 	}
-	assert(stream->GetPos() == CREOffset);
 	return 0;
 }
 
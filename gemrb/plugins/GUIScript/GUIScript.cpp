@@ -40,6 +40,7 @@
 #include "MusicMgr.h"
 #include "Palette.h"
 #include "PalettedImageMgr.h"
+#include "Profiler.h"
 #include "ResourceDesc.h"
 #include "RNG.h"
 #include "SaveGameIterator.h"
@@ -532,6 +533,38 @@ static PyObject* GemRB_GetString(PyObject * /*self*/, PyObject* args)
 	return PyString_FromStringObj(text);
 }
 
+PyDoc_STRVAR( GemRB_PrefetchStrings__doc,
+"===== PrefetchStrings =====\n\
+\n\
+**Prototype:** GemRB.PrefetchStrings (Strrefs)\n\
+\n\
+**Description:** Decodes the given strings in one go, so that a screen that \n\
+shows many of them doesn't have to look them up one by one.\n\
+\n\
+**Parameters:** \n\
+  * Strrefs - a list of string references\n\
+\n\
+**Return value:** N/A\n\
+\n\
+**See also:** [GetString](GetString.md)"
+);
+
+static PyObject* GemRB_PrefetchStrings(PyObject * /*self*/, PyObject* args)
+{
+	PyObject* list = nullptr;
+	PARSE_ARGS(args, "O", &list);
+	if (!PyList_Check(list)) {
+		return RuntimeError("Expected a list of strrefs!");
+	}
+
+	std::vector<ieStrRef> strrefs;
+	for (Py_ssize_t i = 0; i < PyList_Size(list); i++) {
+		strrefs.push_back(StrRefFromPy(PyList_GetItem(list, i)));
+	}
+	core->PrefetchStrings(strrefs);
+	Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR( GemRB_EndCutSceneMode__doc,
 "===== EndCutSceneMode =====\n\
 \n\
@@ -4471,6 +4504,71 @@ static PyObject* GemRB_DumpActor(PyObject * /*self*/, PyObject * args)
 	Py_RETURN_NONE;
 }
 
+PyDoc_STRVAR( GemRB_EnableProfiler__doc,
+"===== EnableProfiler =====\n\
+\n\
+**Prototype:** GemRB.EnableProfiler (flag)\n\
+\n\
+**Description:** Turns the subsystem profiler on or off. While it is on, \n\
+the per-frame timings are drawn in an overlay and trace events are recorded.\n\
+\n\
+**Parameters:** flag - boolean\n\
+\n\
+**Return value:** N/A\n\
+\n\
+**See also:** [DumpProfile](DumpProfile.md)"
+);
+
+static PyObject* GemRB_EnableProfiler(PyObject * /*self*/, PyObject* args)
+{
+	int flag = 0;
+	PARSE_ARGS(args, "i", &flag);
+	Profiler::Enable(flag);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR( GemRB_DumpProfile__doc,
+"===== DumpProfile =====\n\
+\n\
+**Prototype:** GemRB.DumpProfile (filename)\n\
+\n\
+**Description:** Writes the events recorded by the profiler in the chrome \n\
+trace format (load it in chrome://tracing or perfetto).\n\
+\n\
+**Parameters:**\n\
+  * filename - path of the json file to write\n\
+\n\
+**Return value:** boolean, success\n\
+\n\
+**See also:** [EnableProfiler](EnableProfiler.md)"
+);
+
+static PyObject* GemRB_DumpProfile(PyObject * /*self*/, PyObject* args)
+{
+	const char* filename = nullptr;
+	PARSE_ARGS(args, "s", &filename);
+	return PyBool_FromLong(Profiler::DumpTrace(filename));
+}
+
+PyDoc_STRVAR( GemRB_RefreshResources__doc,
+"===== RefreshResources =====\n\
+\n\
+**Prototype:** GemRB.RefreshResources ()\n\
+\n\
+**Description:** Rescans the override and other cached directories and \n\
+forgets all resource lookups, so files added while running are picked up.\n\
+\n\
+**Parameters:** N/A\n\
+\n\
+**Return value:** N/A"
+);
+
+static PyObject* GemRB_RefreshResources(PyObject * /*self*/, PyObject* /*args*/)
+{
+	gamedata->Refresh();
+	Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR( GemRB_SaveCharacter__doc,
 "===== SaveCharacter =====\n\
 \n\
@@ -13167,7 +13265,9 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(DragItem, METH_VARARGS),
 	METHOD(DropDraggedItem, METH_VARARGS),
 	METHOD(DumpActor, METH_VARARGS),
+	METHOD(DumpProfile, METH_VARARGS),
 	METHOD(EnableCheatKeys, METH_VARARGS),
+	METHOD(EnableProfiler, METH_VARARGS),
 	METHOD(EndCutSceneMode, METH_NOARGS),
 	METHOD(EnterGame, METH_NOARGS),
 	METHOD(EnterStore, METH_VARARGS),
@@ -13291,7 +13391,9 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(QuitGame, METH_NOARGS),
 	METHOD(PlaySound, METH_VARARGS),
 	METHOD(PlayMovie, METH_VARARGS),
+	METHOD(PrefetchStrings, METH_VARARGS),
 	METHOD(PrepareSpontaneousCast, METH_VARARGS),
+	METHOD(RefreshResources, METH_NOARGS),
 	METHOD(RemoveItem, METH_VARARGS),
 	METHOD(RemoveSpell, METH_VARARGS),
 	METHOD(RemoveEffects, METH_VARARGS),
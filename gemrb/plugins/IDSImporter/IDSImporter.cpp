@@ -30,6 +30,19 @@ using namespace GemRB;
 
 const std::string blank;
 
+// the lookups used to be done with stricmp, so keys end at the first null
+static size_t KeyLength(const StringView& key)
+{
+	const char* end = static_cast<const char*>(memchr(key.c_str(), '\0', key.length()));
+	return end ? end - key.c_str() : key.length();
+}
+
+bool IDSImporter::KeyEqualCI::operator()(const StringView& a, const StringView& b) const
+{
+	size_t len = KeyLength(a);
+	return len == KeyLength(b) && strnicmp(a.c_str(), b.c_str(), len) == 0;
+}
+
 bool IDSImporter::Open(DataStream* str)
 {
 	if (str == NULL) {
@@ -58,27 +71,40 @@ bool IDSImporter::Open(DataStream* str)
 	}
 
 	delete str;
+
+	valueByString.reserve(pairs.size());
+	indexByValue.reserve(pairs.size());
+	for (int i = 0; i < static_cast<int>(pairs.size()); ++i) {
+		const Pair& pair = pairs[i];
+		valueByString.emplace(StringView(pair.str), pair.val);
+
+		auto res = indexByValue.emplace(pair.val, std::make_pair(i, i));
+		res.first->second.second = i;
+
+		auto paren = pair.str.find('(');
+		if (paren != std::string::npos) {
+			indexByHead[StringView(pair.str.c_str(), paren + 1)] = i;
+		}
+	}
 	return true;
 }
 
 int IDSImporter::GetValue(StringView txt) const
 {
-	for (const auto& pair : pairs) {
-		if (stricmp(pair.str.c_str(), txt.c_str()) == 0) {
-			return pair.val;
-		}
+	auto it = valueByString.find(txt);
+	if (it == valueByString.end()) {
+		return -1;
 	}
-	return -1;
+	return it->second;
 }
 
 const std::string& IDSImporter::GetValue(int val) const
 {
-	for (const auto& pair : pairs) {
-		if (pair.val == val) {
-			return pair.str;
-		}
+	auto it = indexByValue.find(val);
+	if (it == indexByValue.end()) {
+		return blank;
 	}
-	return blank;
+	return pairs[it->second.first].str;
 }
 
 const std::string& IDSImporter::GetStringIndex(size_t Index) const
@@ -99,6 +125,16 @@ int IDSImporter::GetValueIndex(size_t Index) const
 
 int IDSImporter::FindString(StringView str) const
 {
+	// script compilation looks up "name(", which can only prefix entries with the same head
+	size_t len = str.length();
+	if (len && KeyLength(str) == len && memchr(str.c_str(), '(', len) == str.c_str() + len - 1) {
+		auto it = indexByHead.find(str);
+		if (it == indexByHead.end()) {
+			return -1;
+		}
+		return it->second;
+	}
+
 	int i = static_cast<int>(pairs.size());
 	while(i--) {
 		if (strnicmp(pairs[i].str.c_str(), str.c_str(), str.length()) == 0) {
@@ -110,13 +146,11 @@ int IDSImporter::FindString(StringView str) const
 
 int IDSImporter::FindValue(int val) const
 {
-	int i = static_cast<int>(pairs.size());
-	while(i--) {
-		if(pairs[i].val==val) {
-			return i;
-		}
+	auto it = indexByValue.find(val);
+	if (it == indexByValue.end()) {
+		return -1;
 	}
-	return -1;
+	return it->second.second;
 }
 
 int IDSImporter::GetHighestValue() const
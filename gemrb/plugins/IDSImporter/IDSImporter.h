@@ -22,8 +22,10 @@
 #define IDSIMPORTER_H
 
 #include "SymbolMgr.h"
+#include "Strings/CString.h"
 #include "Strings/StringView.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
@@ -39,8 +41,19 @@ private:
 		{}
 	};
 
+	struct KeyEqualCI {
+		bool operator()(const StringView& a, const StringView& b) const;
+	};
+	template <typename T>
+	using key_index_t = std::unordered_map<StringView, T, CstrHashCI<StringView>, KeyEqualCI>;
+
 	std::vector<Pair> pairs;
 
+	// all keys point into pairs, which never changes after Open
+	key_index_t<int> valueByString; // first pair with the string
+	key_index_t<int> indexByHead; // last pair starting with "name(", for FindString
+	std::unordered_map<int, std::pair<int, int>> indexByValue; // first and last pair with the value
+
 public:
 	IDSImporter() noexcept = default;
 
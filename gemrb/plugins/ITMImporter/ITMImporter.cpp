@@ -25,6 +25,7 @@
 #include "PluginMgr.h"
 #include "SymbolMgr.h"
 #include "TableMgr.h" //needed for autotable
+#include "Streams/RecordReader.h"
 
 #include <map>
 
@@ -274,41 +275,42 @@ Item* ITMImporter::GetItem(Item *s)
 
 void ITMImporter::GetExtHeader(const Item *s, ITMExtHeader* eh)
 {
+	RecordReader<56> record(str);
 	ieByte tmpByte;
-	ieWord ProjectileType;
-
-	str->Read( &eh->AttackType,1 );
-	str->Read( &eh->IDReq,1 );
-	str->Read( &eh->Location,1 );
-	str->Read(&eh->AltDiceSides, 1);
-	str->ReadResRef( eh->UseIcon );
-	str->Read( &eh->Target,1 );
-	str->Read( &tmpByte,1 );
+	ieByte ProjectileType;
+
+	record.Read(eh->AttackType);
+	record.Read(eh->IDReq);
+	record.Read(eh->Location);
+	record.Read(eh->AltDiceSides);
+	record.ReadResRef(eh->UseIcon);
+	record.Read(eh->Target);
+	record.Read(tmpByte);
 	if (!tmpByte) {
 		tmpByte = 1;
 	}
 	eh->TargetNumber = tmpByte;
-	str->ReadWord(eh->Range);
-	str->Read(&ProjectileType, 1);
-	str->Read(&eh->AltDiceThrown, 1);
-	str->Read(&eh->Speed, 1);
-	str->Read(&eh->AltDamageBonus, 1);
-	str->ReadWord(eh->THAC0Bonus);
-	str->ReadWord(eh->DiceSides);
-	str->ReadWord(eh->DiceThrown);
-	str->ReadScalar<ieWordSigned>(eh->DamageBonus);
-	str->ReadWord(eh->DamageType);
+	record.Read(eh->Range);
+	record.Read(ProjectileType);
+	record.Read(eh->AltDiceThrown);
+	record.Read(eh->Speed);
+	record.Read(eh->AltDamageBonus);
+	record.Read(eh->THAC0Bonus);
+	record.Read(eh->DiceSides);
+	record.Read(eh->DiceThrown);
+	record.Read(eh->DamageBonus);
+	record.Read(eh->DamageType);
 	ieWord featureCount;
-	str->ReadWord(featureCount);
-	str->ReadWord(eh->FeatureOffset);
-	str->ReadWord(eh->Charges);
-	str->ReadWord(eh->ChargeDepletion);
-	str->ReadDword(eh->RechargeFlags);
+	record.Read(featureCount);
+	record.Read(eh->FeatureOffset);
+	record.Read(eh->Charges);
+	record.Read(eh->ChargeDepletion);
+	record.Read(eh->RechargeFlags);
 
 	//hack for default weapon finesse
 	if (s->ItemType==IT_DAGGER || s->ItemType==IT_SHORTSWORD) eh->RechargeFlags^=IE_ITEM_USEDEXTERITY;
 
-	str->ReadWord(eh->ProjectileAnimation);
+	record.Read(eh->ProjectileAnimation);
 	//for some odd reasons 0 and 1 are the same
 	if (eh->ProjectileAnimation) {
 		eh->ProjectileAnimation--;
@@ -320,16 +322,16 @@ void ITMImporter::GetExtHeader(const Item *s, ITMExtHeader* eh)
 	}
 
 	for (unsigned short& i : eh->MeleeAnimation) {
-		str->ReadWord(i);
+		record.Read(i);
 	}
 
 	ieWord tmp;
 	ieDword pq = 0;
-	str->ReadWord(tmp); //arrow
+	record.Read(tmp); //arrow
 	if (tmp) pq |= PROJ_ARROW;
-	str->ReadWord(tmp); //xbow
+	record.Read(tmp); //xbow
 	if (tmp) pq |= PROJ_BOLT;
-	str->ReadWord(tmp); //bullet
+	record.Read(tmp); //bullet
 	if (tmp) pq |= PROJ_BULLET;
 	//this hack is required for Nordom's crossbow in PST
 	if (!pq && (eh->AttackType == ITEM_AT_BOW)) {
@@ -0,0 +1,61 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2022 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "NullVideo.h"
+
+#include <cstdlib>
+
+using namespace GemRB;
+
+class NullVideoBuffer : public VideoBuffer {
+public:
+	explicit NullVideoBuffer(const Region& r) : VideoBuffer(r) {}
+
+	void Clear(const Region&) override {}
+	void CopyPixels(const Region&, const void*, const int*, ...) override {}
+	bool RenderOnDisplay(void*) const override { return true; }
+};
+
+VideoBuffer* NullVideoDriver::NewVideoBuffer(const Region& r, BufferFormat)
+{
+	return new NullVideoBuffer(r);
+}
+
+Holder<Sprite2D> NullVideoDriver::CreateSprite(const Region& rgn, void* pixels, const PixelFormat& fmt)
+{
+	return MakeHolder<Sprite2D>(rgn, pixels, fmt);
+}
+
+Holder<Sprite2D> NullVideoDriver::GetScreenshot(Region r, const VideoBufferPtr&)
+{
+	// there is nothing to capture, but savegames still want a (black) preview
+	int width = r.w ? r.w : screenSize.w;
+	int height = r.h ? r.h : screenSize.h;
+
+	static const PixelFormat fmt(4, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+	void* pixels = calloc(width * height, fmt.Bpp);
+	return MakeHolder<Sprite2D>(Region(0, 0, width, height), pixels, fmt);
+}
+
+#include "plugindef.h"
+
+GEMRB_PLUGIN(0x3C4E0A1, "Null Video Driver")
+PLUGIN_DRIVER(NullVideoDriver, "none")
+END_PLUGIN()
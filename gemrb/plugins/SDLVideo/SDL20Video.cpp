@@ -380,6 +380,53 @@ void SDL20VideoDriver::BlitVideoBuffer(const VideoBufferPtr& buf, const Point& p
 	BlitSpriteNativeClipped(tex, srect, drect, flags, reinterpret_cast<const SDL_Color*>(&tint));
 }
 
+void SDL20VideoDriver::BlitSprites(const Holder<Sprite2D>& spr, const std::vector<SpriteBlit>& blits,
+								   BlitFlags flags, Color tint)
+{
+	// stencils, software effects and the shaders need their own setup for every blit
+	bool batched = !spr->Format().RLE && !(flags & (BLIT_STENCIL_MASK | BlitFlags::GREY | BlitFlags::SEPIA));
+	batched &= !(spr->Format().Bpp == 1 && (flags & BlitFlags::ALPHA_MOD));
+#if USE_OPENGL_BACKEND
+	batched = false;
+#endif
+	if (!batched) {
+		Video::BlitSprites(spr, blits, flags, tint);
+		return;
+	}
+
+	// the same adjustments BlitSpriteClipped makes, but only once for the whole run
+	if (spr->renderFlags & BlitFlags::MIRRORX) {
+		flags ^= BlitFlags::MIRRORX;
+	}
+	if (spr->renderFlags & BlitFlags::MIRRORY) {
+		flags ^= BlitFlags::MIRRORY;
+	}
+	if (!spr->HasTransparency()) {
+		flags &= ~BlitFlags::BLENDED;
+	}
+
+	const sprite_t* native = static_cast<const sprite_t*>(spr.get());
+	flags &= ~native->RenderWithFlags(BlitFlags::NONE);
+	SDL_Texture* tex = native->GetTexture(renderer);
+
+	UpdateRenderTarget();
+	SetTextureState(tex, flags, reinterpret_cast<const SDL_Color*>(&tint));
+	SDL_RendererFlip flipflags = FlipFlags(flags);
+
+	for (const SpriteBlit& blit : blits) {
+		Region dst(blit.dst.origin - spr->Frame.origin, blit.dst.size);
+		if (ClippedDrawingRect(dst).size.IsInvalid()) {
+			continue;
+		}
+
+		SDL_Rect srect = RectFromRegion(blit.src);
+		SDL_Rect drect = RectFromRegion(dst);
+		if (SDL_RenderCopyEx(renderer, tex, &srect, &drect, 0.0, nullptr, flipflags) != 0) {
+			Log(ERROR, "SDLVideo", "{}", SDL_GetError());
+		}
+	}
+}
+
 int SDL20VideoDriver::RenderCopyShaded(SDL_Texture* texture, const SDL_Rect* srcrect,
 									   const SDL_Rect* dstrect, BlitFlags flags, const SDL_Color* tint)
 {
@@ -477,7 +524,13 @@ int SDL20VideoDriver::RenderCopyShaded(SDL_Texture* texture, const SDL_Rect* src
 		glBindTexture(GL_TEXTURE_2D, stencilTextureID);
 	}
 #endif
-	
+
+	SetTextureState(texture, flags, tint);
+	return SDL_RenderCopyEx(renderer, texture, srcrect, dstrect, 0.0, nullptr, FlipFlags(flags));
+}
+
+void SDL20VideoDriver::SetTextureState(SDL_Texture* texture, BlitFlags flags, const SDL_Color* tint)
+{
 	Uint8 alpha = SDL_ALPHA_OPAQUE;
 	if (flags & BlitFlags::ALPHA_MOD) {
 		alpha = tint->a;
@@ -504,11 +557,12 @@ int SDL20VideoDriver::RenderCopyShaded(SDL_Texture* texture, const SDL_Rect* src
 	} else {
 		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
 	}
+}
 
+SDL_RendererFlip SDL20VideoDriver::FlipFlags(BlitFlags flags)
+{
 	SDL_RendererFlip flipflags = (flags & BlitFlags::MIRRORY) ? SDL_FLIP_VERTICAL : SDL_FLIP_NONE;
-	flipflags = static_cast<SDL_RendererFlip>(flipflags | ((flags & BlitFlags::MIRRORX) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE));
-
-	return SDL_RenderCopyEx(renderer, texture, srcrect, dstrect, 0.0, nullptr, flipflags);
+	return static_cast<SDL_RendererFlip>(flipflags | ((flags & BlitFlags::MIRRORX) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE));
 }
 
 void SDL20VideoDriver::DrawPointsImp(const std::vector<Point>& points, const Color& color, BlitFlags flags)
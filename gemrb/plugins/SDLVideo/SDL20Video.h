@@ -241,6 +241,8 @@ public:
 
 	void BlitVideoBuffer(const VideoBufferPtr& buf, const Point& p, BlitFlags flags,
 						 Color tint = Color()) override;
+	void BlitSprites(const Holder<Sprite2D>& spr, const std::vector<SpriteBlit>& blits,
+					 BlitFlags flags, Color tint = Color()) override;
 private:
 	VideoBuffer* NewVideoBuffer(const Region&, BufferFormat) override;
 
@@ -276,6 +278,8 @@ private:
 	void BlitSpriteNativeClipped(SDL_Texture* spr, const Region& src, const Region& dst, BlitFlags flags = BlitFlags::NONE, const SDL_Color* tint = NULL);
 
 	int RenderCopyShaded(SDL_Texture*, const SDL_Rect* srcrect, const SDL_Rect* dstrect, BlitFlags flags, const SDL_Color* = nullptr);
+	static void SetTextureState(SDL_Texture*, BlitFlags flags, const SDL_Color* tint);
+	static SDL_RendererFlip FlipFlags(BlitFlags flags);
 
 	int GetTouchFingers(TouchEvent::Finger(&fingers)[FINGER_MAX], SDL_TouchID device) const;
 };
@@ -24,6 +24,7 @@
 #include "Interface.h"
 #include "PluginMgr.h"
 #include "TableMgr.h" //needed for autotable
+#include "Streams/RecordReader.h"
 
 using namespace GemRB;
 
@@ -186,15 +187,16 @@ Spell* SPLImporter::GetSpell(Spell *s, bool /*silent*/)
 
 void SPLImporter::GetExtHeader(const Spell *s, SPLExtHeader* eh)
 {
+	RecordReader<40> record(str);
 	ieByte tmpByte;
 
-	str->Read( &eh->SpellForm, 1 );
+	record.Read(eh->SpellForm);
 	//this byte is used in PST
-	str->Read( &eh->Hostile, 1 );
-	str->Read( &eh->Location, 1 );
-	str->Read( &eh->unknown2, 1 );
-	str->ReadResRef(eh->memorisedIcon);
-	str->Read( &eh->Target, 1 );
+	record.Read(eh->Hostile);
+	record.Read(eh->Location);
+	record.Read(eh->unknown2);
+	record.ReadResRef(eh->memorisedIcon);
+	record.Read(eh->Target);
 
 	//this hack is to let gemrb target dead actors by some spells
 	if (eh->Target == 1) {
@@ -202,24 +204,24 @@ void SPLImporter::GetExtHeader(const Spell *s, SPLExtHeader* eh)
 			eh->Target = 3;
 		}
 	}
-	str->Read( &tmpByte,1 );
+	record.Read(tmpByte);
 	if (!tmpByte) {
 		tmpByte = 1;
 	}
 	eh->TargetNumber = tmpByte;
-	str->ReadWord(eh->Range);
-	str->ReadWord(eh->RequiredLevel);
-	str->ReadDword(eh->CastingTime);
-	str->ReadWord(eh->DiceSides);
-	str->ReadWord(eh->DiceThrown);
-	str->ReadWord(eh->DamageBonus);
-	str->ReadWord(eh->DamageType);
+	record.Read(eh->Range);
+	record.Read(eh->RequiredLevel);
+	record.Read(eh->CastingTime);
+	record.Read(eh->DiceSides);
+	record.Read(eh->DiceThrown);
+	record.Read(eh->DamageBonus);
+	record.Read(eh->DamageType);
 	ieWord featureCount;
-	str->ReadWord(featureCount);
-	str->ReadWord(eh->FeatureOffset);
-	str->ReadWord(eh->Charges);
-	str->ReadWord(eh->ChargeDepletion);
-	str->ReadWord(eh->ProjectileAnimation);
+	record.Read(featureCount);
+	record.Read(eh->FeatureOffset);
+	record.Read(eh->Charges);
+	record.Read(eh->ChargeDepletion);
+	record.Read(eh->ProjectileAnimation);
 
 	//for some odd reasons 0 and 1 are the same
 	if (eh->ProjectileAnimation) {
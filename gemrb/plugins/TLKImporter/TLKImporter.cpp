@@ -28,9 +28,16 @@
 #include "TableMgr.h"
 #include "GUI/GameControl.h"
 #include "Scriptable/Actor.h"
+#include "Streams/MemoryStream.h"
 
 using namespace GemRB;
 
+// how many decoded strings are kept around
+static constexpr size_t MAX_CACHED_STRINGS = 4096;
+// the size of the header and of each entry
+static constexpr ieDword TLK_HEADER_SIZE = 18;
+static constexpr ieDword TLK_ENTRY_SIZE = 0x1A;
+
 struct gt_type
 {
 	int type;
@@ -115,6 +122,15 @@ bool TLKImporter::Open(DataStream* stream)
 		Log(ERROR, "TLKImporter", "Too many strings ({}), increase OVERRIDE_START.", StrRefCount);
 		return false;
 	}
+
+	entryCache.clear();
+	recentStrRefs.clear();
+	const MemoryStream* memory = dynamic_cast<const MemoryStream*>(str);
+	if (memory && memory->Data() && str->Size() >= TLK_HEADER_SIZE + StrRefCount * TLK_ENTRY_SIZE) {
+		mapped = memory->Data();
+	} else {
+		mapped = nullptr;
+	}
 	return true;
 }
 
@@ -332,6 +348,107 @@ ieStrRef TLKImporter::UpdateString(ieStrRef strref, const String& newvalue)
 	return OverrideTLK->UpdateString(strref, newvalue);
 }
 
+bool TLKImporter::ReadEntry(ieStrRef strref, TLKEntry& entry) const
+{
+	ieDword strOffset = 0;
+	ieDword length = 0;
+	// volume and pitch variance fields are known to be unused at minimum in bg1
+	if (mapped) {
+		if (ieDword(strref) >= StrRefCount) {
+			return false;
+		}
+
+		const ieByte* raw = reinterpret_cast<const ieByte*>(mapped) + TLK_HEADER_SIZE + ieDword(strref) * TLK_ENTRY_SIZE;
+		auto LittleDword = [](const ieByte* p) {
+			return ieDword(p[0]) | ieDword(p[1]) << 8 | ieDword(p[2]) << 16 | ieDword(p[3]) << 24;
+		};
+		entry.type = ieWord(raw[0] | raw[1] << 8);
+		memcpy(entry.sound.begin(), raw + 2, 8);
+		RTrim(entry.sound);
+		strOffset = LittleDword(raw + 18);
+		length = LittleDword(raw + 22);
+	} else {
+		ieDword volume;
+		ieDword pitch;
+		if (str->Seek(TLK_HEADER_SIZE + ieDword(strref) * TLK_ENTRY_SIZE, GEM_STREAM_START) == GEM_ERROR) {
+			return false;
+		}
+		str->ReadWord(entry.type);
+		str->ReadResRef(entry.sound);
+		str->ReadDword(volume);
+		str->ReadDword(pitch);
+		str->ReadDword(strOffset);
+		str->ReadDword(length);
+	}
+
+	entry.text.clear();
+	if (!(entry.type & 1)) {
+		return true;
+	}
+
+	std::string mbstr(length, '\0');
+	if (mapped) {
+		strpos_t start = strpos_t(strOffset) + Offset;
+		if (start + length > str->Size()) {
+			return false;
+		}
+		memcpy(&mbstr[0], mapped + start, length);
+	} else {
+		str->Seek(strOffset + Offset, GEM_STREAM_START);
+		str->Read(&mbstr[0], length);
+	}
+	String* tmp = StringFromCString(mbstr.c_str());
+	std::swap(entry.text, *tmp);
+	delete tmp;
+	return true;
+}
+
+// returns the cached entry, reading and decoding it on a miss
+const TLKImporter::TLKEntry* TLKImporter::GetEntry(ieStrRef strref)
+{
+	auto it = entryCache.find(ieDword(strref));
+	if (it != entryCache.end()) {
+		recentStrRefs.splice(recentStrRefs.begin(), recentStrRefs, it->second.second);
+		return &it->second.first;
+	}
+
+	TLKEntry entry;
+	if (!ReadEntry(strref, entry)) {
+		return nullptr;
+	}
+
+	if (entryCache.size() >= MAX_CACHED_STRINGS) {
+		entryCache.erase(recentStrRefs.back());
+		recentStrRefs.pop_back();
+	}
+	recentStrRefs.push_front(ieDword(strref));
+	auto& cached = entryCache[ieDword(strref)];
+	cached = std::make_pair(std::move(entry), recentStrRefs.begin());
+	return &cached.first;
+}
+
+void TLKImporter::Prefetch(const std::vector<ieStrRef>& strrefs)
+{
+	// read them in file order, more than the cache holds would just evict each other
+	std::vector<ieStrRef> sorted;
+	for (ieStrRef strref : strrefs) {
+		// the aux strings come from the override and aren't cached
+		if (!strref || (strref >= ieStrRef::BIO_START && strref <= ieStrRef::BIO_END) || ieDword(strref) >= StrRefCount) {
+			continue;
+		}
+		sorted.push_back(strref);
+	}
+	std::sort(sorted.begin(), sorted.end());
+	sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+	if (sorted.size() > MAX_CACHED_STRINGS) {
+		sorted.resize(MAX_CACHED_STRINGS);
+	}
+
+	for (ieStrRef strref : sorted) {
+		GetEntry(strref);
+	}
+}
+
 String TLKImporter::GetString(ieStrRef strref, STRING_FLAGS flags)
 {
 	String string;
@@ -351,27 +468,13 @@ String TLKImporter::GetString(ieStrRef strref, STRING_FLAGS flags)
 		type = 0;
 		SoundResRef.Reset();
 	} else {
-		ieDword Volume, Pitch, StrOffset;
-		ieDword l;
-		if (str->Seek( 18 + (ieDword(strref) * 0x1A), GEM_STREAM_START ) == GEM_ERROR) {
+		const TLKEntry* entry = GetEntry(strref);
+		if (!entry) {
 			return L"";
 		}
-		str->ReadWord(type);
-		str->ReadResRef( SoundResRef );
-		// volume and pitch variance fields are known to be unused at minimum in bg1
-		str->ReadDword(Volume);
-		str->ReadDword(Pitch);
-		str->ReadDword(StrOffset);
-		str->ReadDword(l);
-				
-		if (type & 1) {
-			str->Seek( StrOffset + Offset, GEM_STREAM_START );
-			std::string mbstr(l, '\0');
-			str->Read(&mbstr[0], l);
-			String* tmp = StringFromCString(mbstr.c_str());
-			std::swap(string, *tmp);
-			delete tmp;
-		}
+		type = entry->type;
+		SoundResRef = entry->sound;
+		string = entry->text;
 	}
 
 	if (bool(flags & STRING_FLAGS::RESOLVE_TAGS) || (type & 4)) {
@@ -400,11 +503,11 @@ StringBlock TLKImporter::GetStringBlock(ieStrRef strref, STRING_FLAGS flags)
 	if (empty) {
 		return StringBlock();
 	}
-	ieWord type;
-	str->Seek( 18 + (ieDword(strref) * 0x1A), GEM_STREAM_START );
-	str->ReadWord(type);
 	ResRef soundRef;
-	str->ReadResRef( soundRef );
+	const TLKEntry* entry = GetEntry(strref);
+	if (entry) {
+		soundRef = entry->sound;
+	}
 	return StringBlock(GetString( strref, flags ), soundRef);
 }
 
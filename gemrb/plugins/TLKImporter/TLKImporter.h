@@ -26,11 +26,26 @@
 #include "Variables.h"
 #include "TlkOverride.h"
 
+#include <list>
+#include <unordered_map>
+
 namespace GemRB {
 
 class TLKImporter : public StringMgr {
 private:
 	DataStream* str = nullptr;
+	// the whole file, if the stream is memory mapped
+	const char* mapped = nullptr;
+
+	// a string table entry with its text decoded, but its tags not resolved
+	struct TLKEntry {
+		ieWord type = 0;
+		ResRef sound;
+		String text;
+	};
+	// the recently used entries, the least recently used ones are dropped first
+	std::list<ieDword> recentStrRefs;
+	std::unordered_map<ieDword, std::pair<TLKEntry, std::list<ieDword>::iterator>> entryCache;
 
 	//Data
 	ieWord Language = 0;
@@ -53,8 +68,11 @@ public:
 	/** resolve a string reference */
 	String GetString(ieStrRef strref, STRING_FLAGS flags = STRING_FLAGS::NONE) override;
 	StringBlock GetStringBlock(ieStrRef strref, STRING_FLAGS flags = STRING_FLAGS::NONE) override;
+	void Prefetch(const std::vector<ieStrRef>& strrefs) override;
 	bool HasAltTLK() const override;
 private:
+	const TLKEntry* GetEntry(ieStrRef strref);
+	bool ReadEntry(ieStrRef strref, TLKEntry& entry) const;
 	/** resolves day and monthname tokens */
 	void GetMonthName(int dayandmonth);
 	String ResolveTags(const String& source);